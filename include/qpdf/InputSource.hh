@@ -66,6 +66,12 @@ class QPDF_DLL_CLASS InputSource
     QPDF_DLL
     bool findLast(char const* start_chars, qpdf_offset_t offset, size_t len, Finder& finder);
 
+    // If the entire contents of the input source are available at a fixed memory location, set
+    // data and size to refer to them and return true. Otherwise, return false. The memory may be
+    // read, including from other threads, for as long as the input source exists.
+    QPDF_DLL
+    bool getContiguousData(char const*& data, size_t& size) const;
+
     virtual qpdf_offset_t findAndSkipNextEOL() = 0;
     virtual std::string const& getName() const = 0;
     virtual qpdf_offset_t tell() = 0;
@@ -87,6 +93,13 @@ class QPDF_DLL_CLASS InputSource
   protected:
     qpdf_offset_t last_offset{0};
 
+    // An input source whose entire contents are available at a fixed memory location may call this
+    // so that findFirst, readLine, and QPDFTokenizer can work directly on that memory rather than
+    // reading it through an intermediate buffer. The memory must remain valid and unchanged for the
+    // lifetime of the input source.
+    QPDF_DLL
+    void setContiguousData(char const* data, size_t size);
+
   private:
     class QPDF_DLL_PRIVATE Members
     {
@@ -99,8 +112,14 @@ class QPDF_DLL_CLASS InputSource
       private:
         Members() = default;
         Members(Members const&) = delete;
+
+        char const* data{nullptr};
+        size_t size{0};
     };
 
+    bool findFirstContiguous(
+        char const* start_chars, qpdf_offset_t offset, size_t len, Finder& finder);
+
     std::shared_ptr<Members> m;
 
     // State for fast... methods
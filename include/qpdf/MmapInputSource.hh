@@ -0,0 +1,63 @@
+// Copyright (c) 2005-2024 Jay Berkenbilt
+//
+// This file is part of qpdf.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under
+// the License.
+//
+// Versions of qpdf prior to version 7 were released under the terms of version 2.0 of the Artistic
+// License. At your option, you may continue to consider qpdf to be licensed under those terms.
+// Please see the manual for additional information.
+
+#ifndef QPDF_MMAPINPUTSOURCE_HH
+#define QPDF_MMAPINPUTSOURCE_HH
+
+#include <qpdf/InputSource.hh>
+
+// An input source that maps the entire file into memory. Reads, seeks, and searches are served
+// directly from the mapped region without any system calls, which is faster than FileInputSource
+// for files that are read more than once or accessed out of order. The file must not be modified
+// or truncated by another process while it is mapped. The constructor throws QPDFSystemError if the
+// file can't be opened or mapped and std::range_error if it is too large to be mapped; callers may
+// fall back to FileInputSource in either case.
+class QPDF_DLL_CLASS MmapInputSource: public InputSource
+{
+  public:
+    QPDF_DLL
+    MmapInputSource(char const* filename);
+    QPDF_DLL
+    ~MmapInputSource() override;
+    QPDF_DLL
+    qpdf_offset_t findAndSkipNextEOL() override;
+    QPDF_DLL
+    std::string const& getName() const override;
+    QPDF_DLL
+    qpdf_offset_t tell() override;
+    QPDF_DLL
+    void seek(qpdf_offset_t offset, int whence) override;
+    QPDF_DLL
+    void rewind() override;
+    QPDF_DLL
+    size_t read(char* buffer, size_t length) override;
+    QPDF_DLL
+    void unreadCh(char ch) override;
+
+  private:
+    MmapInputSource(MmapInputSource const&) = delete;
+    MmapInputSource& operator=(MmapInputSource const&) = delete;
+
+    std::string filename;
+    char const* data{nullptr};
+    qpdf_offset_t cur_offset{0};
+    qpdf_offset_t max_offset{0};
+    void* mapping{nullptr};
+};
+
+#endif // QPDF_MMAPINPUTSOURCE_HH
@@ -52,6 +52,15 @@ class QPDF_DLL_CLASS Pl_Flate: public Pipeline
     QPDF_DLL
     void finish() override;
 
+    // Compress or uncompress data, which must be all of the input, and call finish(). This has the
+    // same effect as write() followed by finish() but is faster when the whole input is already in
+    // memory since the output is produced in one buffer and normally passed to the next pipeline
+    // with a single call to write(). For deflate, the buffer is large enough for any output. For
+    // inflate, the buffer starts at no more than output_size_hint, which may be the value of a
+    // stream's /DL key, four times len, or a few megabytes, and doubles in size as it fills.
+    QPDF_DLL
+    void writeAll(unsigned char const* data, size_t len, size_t output_size_hint = 0);
+
     // Globally set compression level from 1 (fastest, least
     // compression) to 9 (slowest, most compression). Use -1 to set
     // the default compression level. This is passed directly to zlib.
@@ -65,9 +74,13 @@ class QPDF_DLL_CLASS Pl_Flate: public Pipeline
     void setWarnCallback(std::function<void(char const*, int)> callback);
 
   private:
+    QPDF_DLL_PRIVATE
+    void initialize();
     QPDF_DLL_PRIVATE
     void handleData(unsigned char const* data, size_t len, int flush);
     QPDF_DLL_PRIVATE
+    bool growOutbuf();
+    QPDF_DLL_PRIVATE
     void checkError(char const* prefix, int error_code);
     QPDF_DLL_PRIVATE
     void warn(char const*, int error_code);
@@ -94,6 +107,7 @@ class QPDF_DLL_CLASS Pl_Flate: public Pipeline
         void* zdata;
         unsigned long long written{0};
         std::function<void(char const*, int)> callback;
+        bool grow_outbuf{false};
     };
 
     std::shared_ptr<Members> m;
@@ -222,6 +222,32 @@ class QPDF
     QPDF_DLL
     void setIgnoreXRefStreams(bool);
 
+    // If true, processFile(char const* filename, ...) maps the file into memory with
+    // MmapInputSource instead of reading it with FileInputSource. This avoids a system call for
+    // every seek and read while parsing. If the file can't be mapped, it is read normally. The file
+    // must not be modified while the QPDF object is using it. This must be called before
+    // processFile.
+    QPDF_DLL
+    void setUseMmap(bool);
+
+    // If true, the contents of large arrays and dictionaries within objects read from the input are
+    // not parsed until they are first accessed. This makes tools that only look at a few keys of
+    // large objects, such as qpdf --show-npages, faster, but it makes reading every object slower.
+    // Problems with the contents of such an array or dictionary are reported when it is accessed.
+    // A deferred array or dictionary in an object stream keeps the object stream's data in memory
+    // until it is parsed. Like an indirect object, a deferred array or dictionary can't be used
+    // once the QPDF it was read from has been destroyed, even if it is a direct object. This must be
+    // called before processFile.
+    QPDF_DLL
+    void setLazyParsing(bool);
+
+    // When reconstructing the cross-reference table of a damaged file, split the scan of the file
+    // for objects among the given number of threads. This only has an effect when the contents of
+    // the input source are accessible directly from memory, as with setUseMmap, and the file is
+    // large. The result is the same as with a single thread.
+    QPDF_DLL
+    void setRecoveryThreads(int);
+
     // By default, any warnings are issued to std::cerr or the error stream specified in a call to
     // setOutputStreams as they are encountered.  If this method is called with a true value,
     // reporting of warnings is suppressed.  You may still retrieve warnings by calling getWarnings.
@@ -316,8 +342,14 @@ class QPDF
     QPDFObjectHandle getTrailer();
     QPDF_DLL
     QPDFObjectHandle getRoot();
+    // Return a copy of the cross-reference table. For files with very many objects, building the
+    // map can take a lot of memory; forEachXRefEntry visits the same entries without copying them.
     QPDF_DLL
     std::map<QPDFObjGen, QPDFXRefEntry> getXRefTable();
+    // Call fn with the object and generation number and the cross-reference entry of each object
+    // in the cross-reference table, in increasing order of object number.
+    QPDF_DLL
+    void forEachXRefEntry(std::function<void(QPDFObjGen, QPDFXRefEntry const&)> fn);
 
     // Public factory methods
 
@@ -655,6 +687,15 @@ class QPDF
     QPDF_DLL
     std::vector<QPDFObjectHandle> getAllObjects();
 
+    // Read every object stream in the file and load the objects they contain, instead of waiting
+    // for the objects to be accessed. Object streams that are only compressed with /FlateDecode are
+    // decompressed on a pool of n_threads threads. Parsing the objects is always done on the
+    // calling thread. This can speed up processing of large files that store most of their objects
+    // in object streams when all objects are going to be read anyway, as when writing the file.
+    // Problems with object streams are reported as warnings as if the objects had been accessed.
+    QPDF_DLL
+    void preloadObjectStreams(int n_threads);
+
     // Optimization support -- see doc/optimization.  Implemented in QPDF_optimization.cc
 
     // The object_stream_data map maps from a "compressed" object to the object stream that contains
@@ -732,6 +773,7 @@ class QPDF
     class StreamCopier;
     class Objects;
     class ParseGuard;
+    class DeferredInput;
     class Pipe;
     class JobSetter;
 
@@ -801,6 +843,10 @@ class QPDF
 
     // For QPDFWriter:
 
+    bool getRawStreamDataRange(QPDFObjectHandle& stream, qpdf_offset_t& offset, size_t& length);
+    static void pipeRawStreamData(
+        InputSource& file, qpdf_offset_t offset, size_t length, Pipeline* pipeline);
+
     template <typename T>
     void optimize_internal(
         T const& object_stream_data,
@@ -879,6 +925,7 @@ class QPDF
     struct CHSharedObjectEntry;
     struct CHSharedObject;
     class ObjUser;
+    class ObjUserMap;
     struct UpdateObjectMapsFrame;
     class PatternFinder;
 
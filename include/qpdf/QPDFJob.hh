@@ -595,6 +595,7 @@ class QPDFJob
         bool decrypt{false};
         bool remove_restrictions{false};
         int split_pages{0};
+        int jobs{1};
         bool progress{false};
         std::function<void(int)> progress_handler{nullptr};
         bool suppress_warnings{false};
@@ -633,6 +634,7 @@ class QPDFJob
         bool recompress_flate{false};
         bool recompress_flate_set{false};
         int compression_level{-1};
+        int compression_threads{0};
         qpdf_stream_decode_level_e decode_level{qpdf_dl_generalized};
         bool decode_level_set{false};
         bool normalize_set{false};
@@ -641,6 +643,10 @@ class QPDFJob
         bool object_stream_set{false};
         qpdf_object_stream_e object_stream_mode{qpdf_o_preserve};
         bool ignore_xref_streams{false};
+        bool use_mmap{false};
+        bool lazy_parsing{false};
+        int preload_object_streams{0};
+        int recovery_threads{1};
         bool qdf_mode{false};
         bool preserve_unreferenced_objects{false};
         remove_unref_e remove_unreferenced_page_resources{re_auto};
@@ -648,6 +654,10 @@ class QPDFJob
         bool keep_files_open_set{false};
         size_t keep_files_open_threshold{DEFAULT_KEEP_FILES_OPEN_THRESHOLD};
         bool newline_before_endstream{false};
+        bool indirect_stream_lengths{false};
+        bool release_written_objects{false};
+        size_t linearization_cache_size{0};
+        bool linearization_cache_file{false};
         std::string linearize_pass1;
         bool coalesce_contents{false};
         bool flatten_annotations{false};
@@ -714,6 +724,7 @@ class QPDFJob
         bool json_output{false};
         std::string update_from_json;
         bool report_mem_usage{false};
+        bool report_linearization_times{false};
         std::vector<PageLabelSpec> page_label_specs;
     };
     std::shared_ptr<Members> m;
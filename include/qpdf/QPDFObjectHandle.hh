@@ -353,8 +353,9 @@ class QPDFObjectHandle
     QPDF_DLL
     inline bool isIndirect() const;
 
-    // This returns true for indirect objects from a QPDF that has been destroyed. Trying unparse
-    // such an object will throw a logic_error.
+    // This returns true for indirect objects from a QPDF that has been destroyed and for arrays and
+    // dictionaries from such a QPDF that had not yet been parsed with lazy parsing enabled (see
+    // QPDF::setLazyParsing). Trying unparse such an object will throw a logic_error.
     QPDF_DLL
     bool isDestroyed();
 
@@ -202,16 +202,19 @@ class QPDFTokenizer
     // position of the input source returned by input->tell() points to just after the token, and
     // the input source's "last offset" as returned by input->getLastOffset() points to the
     // beginning of the token. Returns false if the token is bad or if scanning produced an error
-    // message for any reason.
+    // message for any reason. The token's value and raw value are returned in views, which is
+    // defined in QPDFTokenizer_private.hh. This allows the results of calling nextToken to be
+    // accessed without creating a Token, thus avoiding copying information that may not be needed.
 
-    bool nextToken(InputSource& input, std::string const& context, size_t max_len = 0);
+    struct Views;
+    bool
+    nextToken(InputSource& input, std::string const& context, Views& views, size_t max_len = 0);
+    void scanContiguous(
+        char const* data, size_t size, qpdf_offset_t& pos, qpdf_offset_t& offset, Views& views);
 
     // The following methods are only valid after nextToken has been called and until another
-    // QPDFTokenizer method is called. They allow the results of calling nextToken to be accessed
-    // without creating a Token, thus avoiding copying information that may not be needed.
+    // QPDFTokenizer method is called.
     inline token_type_e getType() const noexcept;
-    inline std::string const& getValue() const noexcept;
-    inline std::string const& getRawValue() const noexcept;
     inline std::string const& getErrorMessage() const noexcept;
 
     QPDFTokenizer(QPDFTokenizer const&) = delete;
@@ -301,16 +304,6 @@ QPDFTokenizer::getType() const noexcept
     return this->type;
 }
 inline std::string const&
-QPDFTokenizer::getValue() const noexcept
-{
-    return (this->type == tt_name || this->type == tt_string) ? this->val : this->raw_val;
-}
-inline std::string const&
-QPDFTokenizer::getRawValue() const noexcept
-{
-    return this->raw_val;
-}
-inline std::string const&
 QPDFTokenizer::getErrorMessage() const noexcept
 {
     return this->error_message;
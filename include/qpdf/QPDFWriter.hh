@@ -209,6 +209,16 @@ class QPDFWriter
     QPDF_DLL
     void setRecompressFlate(bool);
 
+    // If n is greater than 1, use a pool of n worker threads to compress stream data with Flate
+    // while the file is being written. Stream data is retrieved and decoded on the calling thread a
+    // bounded number of objects ahead of the output, and only the compression step runs in
+    // parallel, so the output is byte-for-byte identical to what is written without worker
+    // threads. This is most useful in combination with setRecompressFlate(true) or when
+    // compressing many large uncompressed streams. The default is 0, which disables worker
+    // threads.
+    QPDF_DLL
+    void setCompressionThreads(int n);
+
     // Set value of content stream normalization.  The default is "false".  If true, we attempt to
     // normalize newlines inside of content streams.  Some constructs such as inline images may
     // thwart our efforts.  There may be some cases where this can damage the content stream.  This
@@ -233,6 +243,24 @@ class QPDFWriter
     QPDF_DLL
     void setNewlineBeforeEndstream(bool);
 
+    // Write the /Length of each stream as an indirect object that follows the stream, as is done
+    // in QDF mode. Since the length doesn't have to be known before the stream data is written,
+    // stream data that doesn't need to be decoded can be written directly to the output as it is
+    // filtered instead of being held in memory first. Streams that are decoded are still buffered
+    // so that they can be written unfiltered if decoding fails. This adds an object for each
+    // stream. It is ignored when writing linearized or PCLm files.
+    QPDF_DLL
+    void setIndirectStreamLengths(bool);
+
+    // Free the values of objects once they have been written if they can be read again from the
+    // input file when they are needed. This applies to objects that had not been read or accessed
+    // before write() was called, so it never discards changes. With this option, the memory used
+    // while writing a large file depends on the objects being written rather than on the size of
+    // the whole file. Objects that are needed again are read again, which takes some extra time.
+    // This option is ignored when writing linearized or PCLm files.
+    QPDF_DLL
+    void setReleaseWrittenObjects(bool);
+
     // Set the minimum PDF version.  If the PDF version of the input file (or previously set minimum
     // version) is less than the version passed to this method, the PDF version of the output file
     // will be set to this value.  If the original PDF file's version or previously set minimum
@@ -402,6 +430,29 @@ class QPDFWriter
     QPDF_DLL
     void setLinearizationPass1Filename(std::string const&);
 
+    // Linearized files are written in two passes. By default, stream data that has to be filtered
+    // and the contents of object streams are computed again in the second pass. With a non-zero
+    // size, such data computed in the first pass is kept in memory, up to the given number of bytes
+    // in total, and reused in the second pass. This makes writing faster, especially when streams
+    // are compressed while writing, but memory use grows by up to the given size. Data that doesn't
+    // fit is computed again. The default is 0, which keeps nothing in memory.
+    QPDF_DLL
+    void setLinearizationCacheSize(size_t);
+
+    // If true, data that doesn't fit in the memory allowed by setLinearizationCacheSize is written
+    // to a temporary file and read back in the second pass rather than being filtered again. This
+    // is worthwhile when streams are compressed while writing, which takes much longer than
+    // reading the data back. The default is false.
+    QPDF_DLL
+    void setLinearizationCacheFile(bool);
+
+    // When writing a linearized file, call the given function after each phase of writing with
+    // the name of the phase and the number of seconds it took. The phases are "prepare",
+    // "optimize", "order objects", "first pass", "hint stream", and "second pass". This can be used
+    // to find out where the time goes when linearizing large files.
+    QPDF_DLL
+    void registerLinearizationTimer(std::function<void(std::string const& phase, double seconds)>);
+
     // Create PCLm output. This is only useful for clients that know how to create PCLm files. If a
     // file is structured exactly as PCLm requires, this call will tell QPDFWriter to write the PCLm
     // header, create certain unreferenced streams required by the standard, and write the objects
@@ -495,7 +546,18 @@ class QPDFWriter
         QPDFObjectHandle stream,
         bool& compress_stream,
         bool& is_metadata,
-        std::shared_ptr<Buffer>* stream_data);
+        std::shared_ptr<Buffer>* stream_data,
+        bool defer_compression = false,
+        bool allow_unbuffered = false);
+    void prefilterStreams(size_t next);
+    void prefilterStream(QPDFObjectHandle stream);
+    void clearPrefilteredStreams();
+    void cacheFilteredStream(
+        QPDFObjGen og,
+        bool filtered,
+        bool compress_stream,
+        bool is_metadata,
+        std::shared_ptr<Buffer> const& data);
     void unparseObject(
         QPDFObjectHandle object,
         int level,
@@ -129,6 +129,13 @@ namespace QUtil
     QPDF_DLL
     bool file_can_be_opened(char const* filename);
 
+    // Create a new temporary file opened for reading and writing in binary mode. The file is
+    // deleted when it is closed. If it can't be created, throws std::runtime_error. On Windows, the
+    // file is created in the user's temporary directory rather than in the root of the current
+    // drive, where tmpfile() creates it.
+    QPDF_DLL
+    FILE* temp_file();
+
     // Wrap around off_t versions of fseek and ftell if available
     QPDF_DLL
     int seek(FILE* stream, qpdf_offset_t offset, int whence);
@@ -16,11 +16,15 @@ QPDF_DLL Config* filteredStreamData();
 QPDF_DLL Config* flattenRotation();
 QPDF_DLL Config* generateAppearances();
 QPDF_DLL Config* ignoreXrefStreams();
+QPDF_DLL Config* indirectStreamLengths();
 QPDF_DLL Config* isEncrypted();
 QPDF_DLL Config* jsonInput();
 QPDF_DLL Config* keepInlineImages();
+QPDF_DLL Config* lazyParsing();
+QPDF_DLL Config* linearizationCacheFile();
 QPDF_DLL Config* linearize();
 QPDF_DLL Config* listAttachments();
+QPDF_DLL Config* mmap();
 QPDF_DLL Config* newlineBeforeEndstream();
 QPDF_DLL Config* noOriginalObjectIds();
 QPDF_DLL Config* noWarn();
@@ -32,9 +36,11 @@ QPDF_DLL Config* progress();
 QPDF_DLL Config* qdf();
 QPDF_DLL Config* rawStreamData();
 QPDF_DLL Config* recompressFlate();
+QPDF_DLL Config* releaseWrittenObjects();
 QPDF_DLL Config* removeInfo();
 QPDF_DLL Config* removeMetadata();
 QPDF_DLL Config* removePageLabels();
+QPDF_DLL Config* reportLinearizationTimes();
 QPDF_DLL Config* reportMemoryUsage();
 QPDF_DLL Config* requiresPassword();
 QPDF_DLL Config* removeRestrictions();
@@ -53,13 +59,16 @@ QPDF_DLL Config* verbose();
 QPDF_DLL Config* warningExit0();
 QPDF_DLL Config* withImages();
 QPDF_DLL Config* compressionLevel(std::string const& parameter);
+QPDF_DLL Config* compressionThreads(std::string const& parameter);
 QPDF_DLL Config* copyEncryption(std::string const& parameter);
 QPDF_DLL Config* encryptionFilePassword(std::string const& parameter);
 QPDF_DLL Config* forceVersion(std::string const& parameter);
 QPDF_DLL Config* iiMinBytes(std::string const& parameter);
 QPDF_DLL Config* jobJsonFile(std::string const& parameter);
+QPDF_DLL Config* jobs(std::string const& parameter);
 QPDF_DLL Config* jsonObject(std::string const& parameter);
 QPDF_DLL Config* keepFilesOpenThreshold(std::string const& parameter);
+QPDF_DLL Config* linearizationCacheSize(std::string const& parameter);
 QPDF_DLL Config* linearizePass1(std::string const& parameter);
 QPDF_DLL Config* minVersion(std::string const& parameter);
 QPDF_DLL Config* oiMinArea(std::string const& parameter);
@@ -67,6 +76,8 @@ QPDF_DLL Config* oiMinHeight(std::string const& parameter);
 QPDF_DLL Config* oiMinWidth(std::string const& parameter);
 QPDF_DLL Config* password(std::string const& parameter);
 QPDF_DLL Config* passwordFile(std::string const& parameter);
+QPDF_DLL Config* preloadObjectStreams(std::string const& parameter);
+QPDF_DLL Config* recoveryThreads(std::string const& parameter);
 QPDF_DLL Config* removeAttachment(std::string const& parameter);
 QPDF_DLL Config* rotate(std::string const& parameter);
 QPDF_DLL Config* showAttachment(std::string const& parameter);
@@ -12,6 +12,9 @@ BufferInputSource::BufferInputSource(std::string const& description, Buffer* buf
     cur_offset(0),
     max_offset(buf ? QIntC::to_offset(buf->getSize()) : 0)
 {
+    if (max_offset > 0) {
+        setContiguousData(reinterpret_cast<char const*>(buf->getBuffer()), buf->getSize());
+    }
 }
 
 BufferInputSource::BufferInputSource(std::string const& description, std::string const& contents) :
@@ -22,6 +25,9 @@ BufferInputSource::BufferInputSource(std::string const& description, std::string
     max_offset(QIntC::to_offset(buf->getSize()))
 {
     memcpy(buf->getBuffer(), contents.c_str(), contents.length());
+    if (max_offset > 0) {
+        setContiguousData(reinterpret_cast<char const*>(buf->getBuffer()), buf->getSize());
+    }
 }
 
 BufferInputSource::~BufferInputSource()
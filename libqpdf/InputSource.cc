@@ -2,8 +2,58 @@
 
 #include <qpdf/QIntC.hh>
 #include <qpdf/QTC.hh>
+#include <qpdf/sse2.hh>
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
+#include <vector>
+
+namespace
+{
+    // Return the first occurrence of needle, which is n > 0 characters long, that lies entirely
+    // within [p, end), or nullptr if there is none.
+    char const*
+    find_sequence(char const* p, char const* end, char const* needle, size_t n)
+    {
+        if (QIntC::to_size(end - p) < n) {
+            return nullptr;
+        }
+        // last is the last position at which needle could start.
+        char const* last = end - n;
+#ifdef QPDF_SSE2
+        if (n > 1) {
+            // Check 16 starting positions at a time by comparing both the first and last characters
+            // of needle. Only compare the rest of needle where both match. This rejects far more
+            // positions than searching for the first character alone, which is typically something
+            // common like 'e'.
+            auto const first = _mm_set1_epi8(needle[0]);
+            auto const final = _mm_set1_epi8(needle[n - 1]);
+            for (; last - p >= 15; p += 16) {
+                auto a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+                auto b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + n - 1));
+                auto mask = static_cast<unsigned int>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, final))));
+                for (char const* q = p; mask; mask >>= 1, ++q) {
+                    if ((mask & 1) && (memcmp(q + 1, needle + 1, n - 2) == 0)) {
+                        return q;
+                    }
+                }
+            }
+        }
+#endif
+        while (p <= last) {
+            p = static_cast<char const*>(memchr(p, needle[0], QIntC::to_size(last - p) + 1));
+            if (p == nullptr) {
+                return nullptr;
+            }
+            if (memcmp(p, needle, n) == 0) {
+                return p;
+            }
+            ++p;
+        }
+        return nullptr;
+    }
+} // namespace
 
 void
 InputSource::setLastOffset(qpdf_offset_t offset)
@@ -17,6 +67,27 @@ InputSource::getLastOffset() const
     return this->last_offset;
 }
 
+void
+InputSource::setContiguousData(char const* data, size_t size)
+{
+    if (!m) {
+        m = std::shared_ptr<Members>(new Members());
+    }
+    m->data = data;
+    m->size = size;
+}
+
+bool
+InputSource::getContiguousData(char const*& data, size_t& size) const
+{
+    if (!(m && m->data)) {
+        return false;
+    }
+    data = m->data;
+    size = m->size;
+    return true;
+}
+
 std::string
 InputSource::readLine(size_t max_line_length)
 {
@@ -26,6 +97,19 @@ InputSource::readLine(size_t max_line_length)
     // the file, and last_offset will point to position the file had when this method was called.
 
     qpdf_offset_t offset = this->tell();
+    if (m && m->data) {
+        // Same result as below without copying through a temporary buffer.
+        qpdf_offset_t eol = this->findAndSkipNextEOL();
+        this->last_offset = offset;
+        size_t line_length = std::min(QIntC::to_size(eol - offset), max_line_length);
+        if (QIntC::to_size(offset) >= m->size) {
+            return {};
+        }
+        char const* line = m->data + offset;
+        line_length = std::min(line_length, m->size - QIntC::to_size(offset));
+        auto nul = static_cast<char const*>(memchr(line, '\0', line_length));
+        return {line, nul ? QIntC::to_size(nul - line) : line_length};
+    }
     auto bp = std::make_unique<char[]>(max_line_length + 1);
     char* buf = bp.get();
     memset(buf, '\0', max_line_length + 1);
@@ -43,102 +127,87 @@ InputSource::readLine(size_t max_line_length)
 bool
 InputSource::findFirst(char const* start_chars, qpdf_offset_t offset, size_t len, Finder& finder)
 {
-    // Basic approach: search for the first character of start_chars starting from offset but not
-    // going past len (if len != 0). Once the first character is found, see if it is the beginning
-    // of a sequence of characters matching start_chars. If so, call finder.check() to do
-    // caller-specific additional checks. If not, keep searching.
-
-    // This code is tricky and highly subject to off-by-one or other edge case logic errors. See
-    // comments throughout that explain how we're not missing any edge cases. There are also tests
-    // specifically constructed to make sure we caught the edge cases in testing.
+    // Basic approach: search for the first occurrence of start_chars starting from offset such that
+    // its first character is not past len (if len != 0). Once found, call finder.check() to do
+    // caller-specific additional checks. If it fails, keep searching after the first character.
 
-    char buf[1025]; // size known to input_source.cc in libtests
-    // To enable us to guarantee null-termination, save an extra byte so that buf[size] is valid
-    // memory.
-    size_t size = sizeof(buf) - 1;
-    if ((strlen(start_chars) < 1) || (strlen(start_chars) > size)) {
+    size_t const start_len = strlen(start_chars);
+    if ((start_len < 1) || (start_len > 1024)) {
         throw std::logic_error("InputSource::findSource called with"
                                " too small or too large of a character sequence");
     }
 
-    char* p = nullptr;
-    qpdf_offset_t buf_offset = offset;
-    size_t bytes_read = 0;
+    if (m && m->data) {
+        return findFirstContiguous(start_chars, offset, len, finder);
+    }
 
-    // Guarantee that we return from this loop. Each time through, we either return, advance p, or
-    // restart the loop with a condition that will cause return on the next pass. Eventually we will
-    // either be out of range or hit EOF, either of which forces us to return.
+    // Read the data in blocks. Most searches end close to offset, so start with a small block and
+    // make it larger as the search goes on so that long searches need fewer reads. Consecutive
+    // blocks overlap by start_len - 1 bytes so that a match that doesn't fit in one block is found
+    // in the next one.
+    std::vector<char> buf(1024);
+    qpdf_offset_t buf_offset = offset;
     while (true) {
-        // Do we need to read more data? Pretend size = 5, buf starts at 0, and start_chars has 3
-        // characters. buf[5] is valid and null. If p == 2, start_chars could be buf[2] through
-        // buf[4], so p + strlen(start_chars) == buf + size is okay. If p points to buf[size], since
-        // strlen(start_chars) is always >= 1, this overflow test will be correct for that case
-        // regardless of start_chars.
-        if ((p == nullptr) || ((p + strlen(start_chars)) > (buf + bytes_read))) {
-            if (p) {
-                QTC::TC(
-                    "libtests", "InputSource read next block", ((p == buf + bytes_read) ? 0 : 1));
-                buf_offset += (p - buf);
-            }
-            this->seek(buf_offset, SEEK_SET);
-            // Read into buffer and zero out the rest of the buffer including buf[size]. We
-            // allocated an extra byte so that we could guarantee null termination as an extra
-            // protection against overrun when using string functions.
-            bytes_read = this->read(buf, size);
-            if (bytes_read < strlen(start_chars)) {
-                QTC::TC("libtests", "InputSource find EOF", bytes_read == 0 ? 0 : 1);
+        this->seek(buf_offset, SEEK_SET);
+        size_t bytes_read = this->read(buf.data(), buf.size());
+        if (bytes_read < start_len) {
+            QTC::TC("libtests", "InputSource find EOF", bytes_read == 0 ? 0 : 1);
+            return false;
+        }
+        char const* begin = buf.data();
+        char const* end = begin + bytes_read;
+        for (char const* p = find_sequence(begin, end, start_chars, start_len); p;
+             p = find_sequence(p + 1, end, start_chars, start_len)) {
+            if ((len != 0) && (QIntC::to_size((p - begin) + (buf_offset - offset)) >= len)) {
+                QTC::TC("libtests", "InputSource out of range");
                 return false;
             }
-            memset(buf + bytes_read, '\0', 1 + (size - bytes_read));
-            p = buf;
-        }
-
-        // Search for the first character.
-        if ((p = static_cast<char*>(
-                 // line-break
-                 memchr(p, start_chars[0], bytes_read - QIntC::to_size(p - buf)))) != nullptr) {
-            if (p == buf) {
+            if (p == begin) {
                 QTC::TC("libtests", "InputSource found match at buf[0]");
             }
-            // Found first letter.
-            if (len != 0) {
-                // Make sure it's in range.
-                size_t p_relative_offset = QIntC::to_size((p - buf) + (buf_offset - offset));
-                if (p_relative_offset >= len) {
-                    // out of range
-                    QTC::TC("libtests", "InputSource out of range");
-                    return false;
-                }
-            }
-            if ((p + strlen(start_chars)) > (buf + bytes_read)) {
-                // If there are not enough bytes left in the file for start_chars, we will detect
-                // this on the next pass as EOF and return.
-                QTC::TC("libtests", "InputSource not enough bytes");
-                continue;
+            // Call finder.check() with the input source positioned to the point of the match.
+            this->seek(buf_offset + (p - begin), SEEK_SET);
+            if (finder.check()) {
+                return true;
             }
+            QTC::TC("libtests", "InputSource start_chars matched but not check");
+        }
+        QTC::TC("libtests", "InputSource read next block", start_len == 1 ? 0 : 1);
+        buf_offset += QIntC::to_offset(bytes_read - (start_len - 1));
+        if ((len != 0) && (QIntC::to_size(buf_offset - offset) >= len)) {
+            return false;
+        }
+        if (buf.size() < 65536) {
+            buf.resize(buf.size() * 4);
+        }
+    }
+}
 
-            // See if p points to a sequence matching start_chars. We already checked above to make
-            // sure we are not going to overrun memory.
-            if (strncmp(p, start_chars, strlen(start_chars)) == 0) {
-                // Call finder.check() with the input source positioned to the point of the match.
-                this->seek(buf_offset + (p - buf), SEEK_SET);
-                if (finder.check()) {
-                    return true;
-                } else {
-                    QTC::TC("libtests", "InputSource start_chars matched but not check");
-                }
-            } else {
-                QTC::TC("libtests", "InputSource first char matched but not string");
-            }
-            // This occurrence of the first character wasn't a match. Skip over it and keep
-            // searching.
-            ++p;
-        } else {
-            // Trigger reading the next block
-            p = buf + bytes_read;
+bool
+InputSource::findFirstContiguous(
+    char const* start_chars, qpdf_offset_t offset, size_t len, Finder& finder)
+{
+    // This works like findFirst but searches the contiguous data directly. The first character of a
+    // match must start within len bytes of offset (if len != 0), and the whole of start_chars must
+    // fit before the end of the data.
+    this->seek(offset, SEEK_SET);
+    size_t start_len = strlen(start_chars);
+    if (QIntC::to_size(offset) >= m->size) {
+        return false;
+    }
+    char const* begin = m->data + offset;
+    char const* end = m->data + m->size;
+    if ((len != 0) && (len + start_len - 1 < QIntC::to_size(end - begin))) {
+        end = begin + len + start_len - 1;
+    }
+    for (char const* p = find_sequence(begin, end, start_chars, start_len); p;
+         p = find_sequence(p + 1, end, start_chars, start_len)) {
+        this->seek(offset + (p - begin), SEEK_SET);
+        if (finder.check()) {
+            return true;
         }
     }
-    throw std::logic_error("InputSource after while (true)");
+    return false;
 }
 
 bool
@@ -0,0 +1,227 @@
+#include <qpdf/MmapInputSource.hh>
+
+#include <qpdf/QIntC.hh>
+#include <qpdf/QPDFSystemError.hh>
+#include <qpdf/QUtil.hh>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#ifdef _WIN32
+# define NOMINMAX
+# define WIN32_LEAN_AND_MEAN
+# include <io.h>
+# include <windows.h>
+#else
+# include <sys/mman.h>
+# include <sys/stat.h>
+#endif
+
+namespace
+{
+    class FileCloser
+    {
+      public:
+        FileCloser(FILE* f) :
+            f(f)
+        {
+        }
+        ~FileCloser()
+        {
+            fclose(f);
+        }
+
+      private:
+        FILE* f;
+    };
+
+#ifdef _WIN32
+    // Win32 calls report errors through GetLastError rather than errno.
+    void
+    throw_windows_error(std::string const& description, char const* function)
+    {
+        DWORD error = ::GetLastError();
+        LPSTR buffer = nullptr;
+        size_t size = FormatMessageA(
+            FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM |
+                FORMAT_MESSAGE_IGNORE_INSERTS,
+            nullptr,
+            error,
+            MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
+            reinterpret_cast<LPSTR>(&buffer),
+            0,
+            nullptr);
+        std::string message(buffer ? buffer : "", buffer ? size : 0);
+        LocalFree(buffer);
+        throw std::runtime_error(
+            description + ": " + function + " failed with error number " +
+            QUtil::uint_to_string(error) + (message.empty() ? "" : ": " + message));
+    }
+#endif
+} // namespace
+
+MmapInputSource::MmapInputSource(char const* filename) :
+    filename(filename)
+{
+    FILE* f = QUtil::safe_fopen(filename, "rb");
+    FileCloser fc(f);
+    std::string description = std::string("mmap ") + filename;
+#ifdef _WIN32
+    HANDLE fh = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(f)));
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fh, &size)) {
+        throw_windows_error(description, "GetFileSizeEx");
+    }
+    max_offset = QIntC::to_offset(size.QuadPart);
+    if (max_offset > 0) {
+        HANDLE mh = CreateFileMapping(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mh == nullptr) {
+            throw_windows_error(description, "CreateFileMapping");
+        }
+        void* p = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+        if (p == nullptr) {
+            // Get the error before CloseHandle can change it.
+            DWORD error = ::GetLastError();
+            CloseHandle(mh);
+            ::SetLastError(error);
+            throw_windows_error(description, "MapViewOfFile");
+        }
+        mapping = mh;
+        data = static_cast<char const*>(p);
+    }
+#else
+    struct stat st;
+    if (fstat(fileno(f), &st) != 0) {
+        QUtil::throw_system_error(description);
+    }
+    if (!S_ISREG(st.st_mode)) {
+        throw QPDFSystemError(description, ENODEV);
+    }
+    max_offset = QIntC::to_offset(st.st_size);
+    if (max_offset > 0) {
+        void* p = mmap(nullptr, QIntC::to_size(max_offset), PROT_READ, MAP_PRIVATE, fileno(f), 0);
+        if (p == MAP_FAILED) {
+            QUtil::throw_system_error(description);
+        }
+        data = static_cast<char const*>(p);
+    }
+#endif
+    // The mapping stays valid after the file is closed.
+    setContiguousData(data, QIntC::to_size(max_offset));
+}
+
+MmapInputSource::~MmapInputSource()
+{
+    // Must be explicit and not inline -- see QPDF_DLL_CLASS in README-maintainer
+    if (data == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(mapping));
+#else
+    munmap(const_cast<char*>(data), QIntC::to_size(max_offset));
+#endif
+}
+
+qpdf_offset_t
+MmapInputSource::findAndSkipNextEOL()
+{
+    if (cur_offset < 0) {
+        throw std::logic_error("INTERNAL ERROR: MmapInputSource offset < 0");
+    }
+    if (cur_offset >= max_offset) {
+        last_offset = max_offset;
+        cur_offset = max_offset;
+        return max_offset;
+    }
+
+    char const* end = data + max_offset;
+    char const* p = data + cur_offset;
+    while ((p < end) && !((*p == '\r') || (*p == '\n'))) {
+        ++p;
+    }
+    if (p == end) {
+        cur_offset = max_offset;
+        return max_offset;
+    }
+    qpdf_offset_t result = p - data;
+    ++p;
+    while ((p < end) && ((*p == '\r') || (*p == '\n'))) {
+        ++p;
+    }
+    cur_offset = p - data;
+    return result;
+}
+
+std::string const&
+MmapInputSource::getName() const
+{
+    return filename;
+}
+
+qpdf_offset_t
+MmapInputSource::tell()
+{
+    return cur_offset;
+}
+
+void
+MmapInputSource::seek(qpdf_offset_t offset, int whence)
+{
+    switch (whence) {
+    case SEEK_SET:
+        cur_offset = offset;
+        break;
+
+    case SEEK_END:
+        QIntC::range_check(max_offset, offset);
+        cur_offset = max_offset + offset;
+        break;
+
+    case SEEK_CUR:
+        QIntC::range_check(cur_offset, offset);
+        cur_offset += offset;
+        break;
+
+    default:
+        throw std::logic_error("INTERNAL ERROR: invalid argument to MmapInputSource::seek");
+        break;
+    }
+
+    if (cur_offset < 0) {
+        throw std::runtime_error(filename + ": seek before beginning of file");
+    }
+}
+
+void
+MmapInputSource::rewind()
+{
+    cur_offset = 0;
+}
+
+size_t
+MmapInputSource::read(char* buffer, size_t length)
+{
+    if (cur_offset < 0) {
+        throw std::logic_error("INTERNAL ERROR: MmapInputSource offset < 0");
+    }
+    if (cur_offset >= max_offset) {
+        last_offset = max_offset;
+        return 0;
+    }
+
+    last_offset = cur_offset;
+    size_t len = std::min(QIntC::to_size(max_offset - cur_offset), length);
+    memcpy(buffer, data + cur_offset, len);
+    cur_offset += QIntC::to_offset(len);
+    return len;
+}
+
+void
+MmapInputSource::unreadCh(char ch)
+{
+    if (cur_offset > 0) {
+        --cur_offset;
+    }
+}
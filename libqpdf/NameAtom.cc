@@ -0,0 +1,76 @@
+#include <qpdf/NameAtom.hh>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    // A table of shared names. Each thread has its own table, so creating a NameAtom never waits
+    // for another thread, and the reference counts of common names such as /Type are not updated
+    // by several threads at once. An entry's key refers to the string it describes. The string's
+    // deleter removes the entry from the table that created it before freeing the string, so keys
+    // never refer to freed memory. The last NameAtom referring to a string may be destroyed on
+    // another thread, so each table still has a mutex, but it is almost never contended.
+    class Table: public std::enable_shared_from_this<Table>
+    {
+      public:
+        std::shared_ptr<std::string const>
+        intern(std::string_view name)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto iter = names.find(name);
+            if (iter != names.end()) {
+                if (auto result = iter->second.lock()) {
+                    return result;
+                }
+                // The last reference to the name has just been dropped in another thread, which
+                // is waiting to remove this entry.
+                names.erase(iter);
+            }
+            std::shared_ptr<std::string const> result(
+                new std::string(name),
+                [table = shared_from_this()](std::string const* s) { table->release(s); });
+            names.emplace(*result, result);
+            return result;
+        }
+
+      private:
+        void
+        release(std::string const* name)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto iter = names.find(*name);
+                // If the name was interned again after its last reference was dropped, the entry
+                // is for the new copy and must stay.
+                if (iter != names.end() && iter->first.data() == name->data()) {
+                    names.erase(iter);
+                }
+            }
+            delete name;
+        }
+
+        std::mutex mutex;
+        std::unordered_map<std::string_view, std::weak_ptr<std::string const>> names;
+    };
+
+    Table&
+    table()
+    {
+        // Each shared string keeps its table alive, so NameAtoms may outlive the thread that
+        // created them.
+        thread_local auto t = std::make_shared<Table>();
+        return *t;
+    }
+} // namespace
+
+NameAtom::NameAtom()
+{
+    static NameAtom const empty{std::string_view()};
+    name = empty.name;
+}
+
+NameAtom::NameAtom(std::string_view name) :
+    name(table().intern(name))
+{
+}
@@ -1,9 +1,52 @@
 #include <qpdf/Pl_ASCII85Decoder.hh>
 
 #include <qpdf/QTC.hh>
+
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 
+namespace
+{
+    // Decode complete groups of five characters and z abbreviations from the n characters at in
+    // to out, which must have room for 4 * n bytes, stopping at anything else, such as white space
+    // or the end of data marker. Return the number of characters decoded and set written to the
+    // number of bytes written.
+    size_t
+    decode_groups(unsigned char const* in, size_t n, unsigned char* out, size_t& written)
+    {
+        size_t i = 0;
+        written = 0;
+        while (i < n) {
+            if (in[i] == 'z') {
+                memset(out + written, 0, 4);
+                written += 4;
+                ++i;
+                continue;
+            }
+            if (i + 5 > n) {
+                break;
+            }
+            unsigned long long lval = 0;
+            unsigned int out_of_range = 0;
+            for (size_t j = 0; j < 5; ++j) {
+                unsigned int digit = in[i + j] - 33U;
+                out_of_range |= (digit > 84U) ? 1U : 0U;
+                lval = lval * 85 + digit;
+            }
+            if (out_of_range) {
+                break;
+            }
+            for (size_t j = 0; j < 4; ++j) {
+                out[written + j] = static_cast<unsigned char>(lval >> (24 - 8 * j));
+            }
+            written += 4;
+            i += 5;
+        }
+        return i;
+    }
+} // namespace
+
 Pl_ASCII85Decoder::Pl_ASCII85Decoder(char const* identifier, Pipeline* next) :
     Pipeline(identifier, next)
 {
@@ -18,7 +61,21 @@ Pl_ASCII85Decoder::write(unsigned char const* buf, size_t len)
     if (eod > 1) {
         return;
     }
+    unsigned char block[4096];
     for (size_t i = 0; i < len; ++i) {
+        if (pos == 0 && eod == 0) {
+            // Decode complete groups a block at a time until reaching white space or the end of
+            // data.
+            size_t written = 0;
+            while (size_t n = decode_groups(
+                       buf + i, std::min(len - i, sizeof(block) / 4), block, written)) {
+                next()->write(block, written);
+                i += n;
+            }
+            if (i == len) {
+                break;
+            }
+        }
         switch (buf[i]) {
         case ' ':
         case '\f':
@@ -46,15 +103,8 @@ Pl_ASCII85Decoder::write(unsigned char const* buf, size_t len)
                 break;
 
             case 'z':
-                if (pos != 0) {
-                    throw std::runtime_error("unexpected z during base 85 decode");
-                } else {
-                    QTC::TC("libtests", "Pl_ASCII85Decoder read z");
-                    unsigned char zeroes[4];
-                    memset(zeroes, '\0', 4);
-                    next()->write(zeroes, 4);
-                }
-                break;
+                // decode_groups handles z between groups, so this is within a group.
+                throw std::runtime_error("unexpected z during base 85 decode");
 
             default:
                 if ((buf[i] < 33) || (buf[i] > 117)) {
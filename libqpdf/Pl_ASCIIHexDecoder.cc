@@ -1,6 +1,9 @@
 #include <qpdf/Pl_ASCIIHexDecoder.hh>
 
 #include <qpdf/QTC.hh>
+#include <qpdf/hex_functions.hh>
+
+#include <algorithm>
 #include <cctype>
 #include <stdexcept>
 
@@ -18,7 +21,19 @@ Pl_ASCIIHexDecoder::write(unsigned char const* buf, size_t len)
     if (this->eod) {
         return;
     }
+    unsigned char block[512];
     for (size_t i = 0; i < len; ++i) {
+        if (this->pos == 0) {
+            // Decode runs of pairs of hex digits a block at a time.
+            while (size_t n =
+                       hex_decode_block(buf + i, std::min(len - i, 2 * sizeof(block)), block)) {
+                next()->write(block, n / 2);
+                i += n;
+            }
+            if (i == len) {
+                break;
+            }
+        }
         char ch = static_cast<char>(toupper(buf[i]));
         switch (ch) {
         case ' ':
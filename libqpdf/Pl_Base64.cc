@@ -2,6 +2,11 @@
 
 #include <qpdf/QIntC.hh>
 #include <qpdf/QUtil.hh>
+#include <qpdf/sse2.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstring>
 #include <stdexcept>
 
@@ -23,6 +28,120 @@ to_i(int i)
     return static_cast<int>(i);
 }
 
+namespace
+{
+    // The value of each base64 character, accepting the URL-safe alphabet as well, or 0xff for
+    // anything else, including pad characters.
+    constexpr std::array<unsigned char, 256> decode_table = [] {
+        std::array<unsigned char, 256> table{};
+        for (auto& v: table) {
+            v = 0xff;
+        }
+        for (int i = 0; i < 26; ++i) {
+            table[static_cast<size_t>('A' + i)] = static_cast<unsigned char>(i);
+            table[static_cast<size_t>('a' + i)] = static_cast<unsigned char>(26 + i);
+        }
+        for (int i = 0; i < 10; ++i) {
+            table[static_cast<size_t>('0' + i)] = static_cast<unsigned char>(52 + i);
+        }
+        table['+'] = table['-'] = 62;
+        table['/'] = table['_'] = 63;
+        return table;
+    }();
+
+    constexpr char encode_table[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // Decode complete groups of four characters from the n characters at in to out, stopping at
+    // the first group that contains anything other than base64 characters, such as white space or
+    // padding. Return the number of characters decoded.
+    size_t
+    decode_groups(unsigned char const* in, size_t n, unsigned char* out)
+    {
+        size_t i = 0;
+#ifdef QPDF_SSE2
+        auto is = [](__m128i v, char a, char b) {
+            return _mm_or_si128(
+                _mm_cmpeq_epi8(v, _mm_set1_epi8(a)), _mm_cmpeq_epi8(v, _mm_set1_epi8(b)));
+        };
+        for (; i + 16 <= n; i += 16) {
+            auto v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+            auto upper = _mm_sub_epi8(v, _mm_set1_epi8('A'));
+            auto lower = _mm_sub_epi8(v, _mm_set1_epi8('a'));
+            auto digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+            auto is_upper = in_range_epu8(upper, 25);
+            auto is_lower = in_range_epu8(lower, 25);
+            auto is_digit = in_range_epu8(digit, 9);
+            auto is_62 = is(v, '+', '-');
+            auto is_63 = is(v, '/', '_');
+            auto valid = _mm_or_si128(
+                _mm_or_si128(is_upper, is_lower),
+                _mm_or_si128(is_digit, _mm_or_si128(is_62, is_63)));
+            if (_mm_movemask_epi8(valid) != 0xffff) {
+                break;
+            }
+            auto sextets = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_and_si128(is_upper, upper),
+                    _mm_and_si128(is_lower, _mm_add_epi8(lower, _mm_set1_epi8(26)))),
+                _mm_or_si128(
+                    _mm_and_si128(is_digit, _mm_add_epi8(digit, _mm_set1_epi8(52))),
+                    _mm_or_si128(
+                        _mm_and_si128(is_62, _mm_set1_epi8(62)),
+                        _mm_and_si128(is_63, _mm_set1_epi8(63)))));
+            // Combine pairs of 6-bit values into 12 bits in each 16-bit lane and then pairs of
+            // those into 24 bits in each 32-bit lane. The first character is in the low byte.
+            auto v12 = _mm_or_si128(
+                _mm_slli_epi16(_mm_and_si128(sextets, _mm_set1_epi16(0xff)), 6),
+                _mm_srli_epi16(sextets, 8));
+            auto v24 = _mm_or_si128(
+                _mm_slli_epi32(_mm_and_si128(v12, _mm_set1_epi32(0xffff)), 12),
+                _mm_srli_epi32(v12, 16));
+            alignas(16) std::uint32_t groups[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(groups), v24);
+            for (size_t j = 0; j < 4; ++j) {
+                unsigned char* o = out + (i / 4 + j) * 3;
+                o[0] = static_cast<unsigned char>(groups[j] >> 16);
+                o[1] = static_cast<unsigned char>(groups[j] >> 8);
+                o[2] = static_cast<unsigned char>(groups[j]);
+            }
+        }
+#endif
+        for (; i + 4 <= n; i += 4) {
+            unsigned int a = decode_table[in[i]];
+            unsigned int b = decode_table[in[i + 1]];
+            unsigned int c = decode_table[in[i + 2]];
+            unsigned int d = decode_table[in[i + 3]];
+            if ((a | b | c | d) & 0x80) {
+                break;
+            }
+            unsigned int group = (a << 18) | (b << 12) | (c << 6) | d;
+            unsigned char* o = out + i / 4 * 3;
+            o[0] = static_cast<unsigned char>(group >> 16);
+            o[1] = static_cast<unsigned char>(group >> 8);
+            o[2] = static_cast<unsigned char>(group);
+        }
+        return i;
+    }
+
+    // Encode complete groups of three bytes from the n bytes at in to out. Return the number of
+    // bytes encoded.
+    size_t
+    encode_groups(unsigned char const* in, size_t n, unsigned char* out)
+    {
+        size_t i = 0;
+        for (; i + 3 <= n; i += 3) {
+            unsigned int group = (in[i] << 16U) | (in[i + 1] << 8U) | in[i + 2];
+            unsigned char* o = out + i / 3 * 4;
+            o[0] = static_cast<unsigned char>(encode_table[group >> 18]);
+            o[1] = static_cast<unsigned char>(encode_table[(group >> 12) & 0x3f]);
+            o[2] = static_cast<unsigned char>(encode_table[(group >> 6) & 0x3f]);
+            o[3] = static_cast<unsigned char>(encode_table[group & 0x3f]);
+        }
+        return i;
+    }
+} // namespace
+
 Pl_Base64::Pl_Base64(char const* identifier, Pipeline* next, action_e action) :
     Pipeline(identifier, next),
     action(action)
@@ -49,7 +168,19 @@ void
 Pl_Base64::decode(unsigned char const* data, size_t len)
 {
     unsigned char const* p = data;
+    unsigned char block[768];
     while (len > 0) {
+        if (this->pos == 0 && !this->end_of_data) {
+            // Decode complete groups a block at a time until reaching white space or padding.
+            while (size_t n = decode_groups(p, std::min(len, sizeof(block) / 3 * 4), block)) {
+                next()->write(block, n / 4 * 3);
+                p += n;
+                len -= n;
+            }
+            if (len == 0) {
+                break;
+            }
+        }
         if (!QUtil::is_space(to_c(*p))) {
             this->buf[this->pos++] = *p;
             if (this->pos == 4) {
@@ -65,7 +196,19 @@ void
 Pl_Base64::encode(unsigned char const* data, size_t len)
 {
     unsigned char const* p = data;
+    unsigned char block[1024];
     while (len > 0) {
+        if (this->pos == 0) {
+            // Encode complete groups a block at a time.
+            while (size_t n = encode_groups(p, std::min(len, sizeof(block) / 4 * 3), block)) {
+                next()->write(block, n / 3 * 4);
+                p += n;
+                len -= n;
+            }
+            if (len == 0) {
+                break;
+            }
+        }
         this->buf[this->pos++] = *p;
         if (this->pos == 3) {
             flush();
@@ -1,5 +1,6 @@
 #include <qpdf/Pl_Flate.hh>
 
+#include <algorithm>
 #include <climits>
 #include <cstring>
 #include <zlib.h>
@@ -111,6 +112,76 @@ Pl_Flate::write(unsigned char const* data, size_t len)
     }
 }
 
+void
+Pl_Flate::initialize()
+{
+    z_stream& zstream = *(static_cast<z_stream*>(m->zdata));
+    int err = Z_OK;
+
+    // deflateInit and inflateInit are macros that use old-style casts.
+#if ((defined(__GNUC__) && ((__GNUC__ * 100) + __GNUC_MINOR__) >= 406) || defined(__clang__))
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wold-style-cast"
+#endif
+    if (m->action == a_deflate) {
+        err = deflateInit(&zstream, compression_level);
+    } else {
+        err = inflateInit(&zstream);
+    }
+#if ((defined(__GNUC__) && ((__GNUC__ * 100) + __GNUC_MINOR__) >= 406) || defined(__clang__))
+# pragma GCC diagnostic pop
+#endif
+
+    checkError("Init", err);
+    m->initialized = true;
+}
+
+void
+Pl_Flate::writeAll(unsigned char const* data, size_t len, size_t output_size_hint)
+{
+    if (m->outbuf == nullptr) {
+        throw std::logic_error(
+            this->identifier + ": Pl_Flate: writeAll() called after finish() called");
+    }
+    // zlib can only take this much in one call. Anything written earlier has been produced in
+    // out_bufsize pieces already, so just carry on in the same way.
+    static size_t const max_bytes = 1 << 30;
+    if (m->initialized || len == 0 || len > max_bytes) {
+        write(data, len);
+        finish();
+        return;
+    }
+
+    initialize();
+    z_stream& zstream = *(static_cast<z_stream*>(m->zdata));
+    size_t size = 0;
+    if (m->action == a_deflate) {
+        // With this much space, deflate produces all of its output in one call.
+        size = deflateBound(&zstream, QIntC::to_ulong(len));
+    } else {
+        // A hint can't be trusted any more than the rest of the file, so start with no more than
+        // a typical compression ratio allows, up to a few megabytes, and double the buffer as it
+        // fills. Growing by doubling copies each byte of output at most about once more.
+        static size_t const max_initial = 4 << 20;
+        size = std::min(std::min(len, max_initial / 4) * 4, max_initial);
+        if (output_size_hint) {
+            size = std::min(size, output_size_hint);
+        }
+        if (memory_limit) {
+            size = std::min(size, QIntC::to_size(memory_limit) + 1);
+        }
+        m->grow_outbuf = true;
+    }
+    size = std::min(std::max(size, m->out_bufsize), max_bytes);
+    m->outbuf = QUtil::make_shared_array<unsigned char>(size);
+    m->out_bufsize = size;
+    zstream.next_out = m->outbuf.get();
+    zstream.avail_out = QIntC::to_uint(size);
+
+    handleData(data, len, (m->action == a_inflate ? Z_SYNC_FLUSH : Z_FINISH));
+    finish();
+}
+
 void
 Pl_Flate::handleData(unsigned char const* data, size_t len, int flush)
 {
@@ -124,24 +195,7 @@ Pl_Flate::handleData(unsigned char const* data, size_t len, int flush)
     zstream.avail_in = QIntC::to_uint(len);
 
     if (!m->initialized) {
-        int err = Z_OK;
-
-        // deflateInit and inflateInit are macros that use old-style casts.
-#if ((defined(__GNUC__) && ((__GNUC__ * 100) + __GNUC_MINOR__) >= 406) || defined(__clang__))
-# pragma GCC diagnostic push
-# pragma GCC diagnostic ignored "-Wold-style-cast"
-#endif
-        if (m->action == a_deflate) {
-            err = deflateInit(&zstream, compression_level);
-        } else {
-            err = inflateInit(&zstream);
-        }
-#if ((defined(__GNUC__) && ((__GNUC__ * 100) + __GNUC_MINOR__) >= 406) || defined(__clang__))
-# pragma GCC diagnostic pop
-#endif
-
-        checkError("Init", err);
-        m->initialized = true;
+        initialize();
     }
 
     int err = Z_OK;
@@ -183,6 +237,9 @@ Pl_Flate::handleData(unsigned char const* data, size_t len, int flush)
                     done = true;
                 }
                 uLong ready = QIntC::to_ulong(m->out_bufsize - zstream.avail_out);
+                if (!done && zstream.avail_out == 0 && growOutbuf()) {
+                    break;
+                }
                 if (ready > 0) {
                     if (memory_limit && m->action != a_deflate) {
                         m->written += ready;
@@ -204,6 +261,27 @@ Pl_Flate::handleData(unsigned char const* data, size_t len, int flush)
     }
 }
 
+bool
+Pl_Flate::growOutbuf()
+{
+    // Only grow while zlib can use the whole buffer and the output kept so far stays within the
+    // memory limit. Otherwise, write the output in pieces as write() does.
+    static size_t const max_bytes = 1 << 30;
+    size_t size = std::min(2 * m->out_bufsize, max_bytes);
+    if (!m->grow_outbuf || size == m->out_bufsize ||
+        (memory_limit && m->written + size > memory_limit)) {
+        return false;
+    }
+    auto outbuf = QUtil::make_shared_array<unsigned char>(size);
+    memcpy(outbuf.get(), m->outbuf.get(), m->out_bufsize);
+    z_stream& zstream = *(static_cast<z_stream*>(m->zdata));
+    zstream.next_out = outbuf.get() + m->out_bufsize;
+    zstream.avail_out = QIntC::to_uint(size - m->out_bufsize);
+    m->outbuf = outbuf;
+    m->out_bufsize = size;
+    return true;
+}
+
 void
 Pl_Flate::finish()
 {
@@ -3,7 +3,6 @@
 #include <qpdf/QIntC.hh>
 #include <qpdf/QTC.hh>
 #include <qpdf/QUtil.hh>
-#include <cstring>
 #include <stdexcept>
 
 Pl_LZWDecoder::Pl_LZWDecoder(char const* identifier, Pipeline* next, bool early_code_change) :
@@ -13,21 +12,31 @@ Pl_LZWDecoder::Pl_LZWDecoder(char const* identifier, Pipeline* next, bool early_
     if (!next) {
         throw std::logic_error("Attempt to create Pl_LZWDecoder with nullptr as next");
     }
+    // Codes are at most 12 bits, so the table never grows beyond this.
+    table.reserve(4096 - 258);
 }
 
 void
 Pl_LZWDecoder::write(unsigned char const* bytes, size_t len)
 {
-    for (size_t i = 0; i < len; ++i) {
-        buf[next_char_++] = bytes[i];
-        if (next_char_ == 3) {
-            next_char_ = 0;
-        }
-        this->bits_available += 8;
-        if (this->bits_available >= this->code_size) {
-            sendNextCode();
+    try {
+        for (size_t i = 0; i < len; ++i) {
+            this->bit_buffer = (this->bit_buffer << 8) | bytes[i];
+            this->bits_available += 8;
+            if (this->bits_available >= this->code_size) {
+                this->bits_available -= this->code_size;
+                handleCode((this->bit_buffer >> this->bits_available) & ((1U << code_size) - 1U));
+                if (out.size() >= 65536) {
+                    flush();
+                }
+            }
         }
+    } catch (...) {
+        // Pass on everything decoded before the error.
+        flush();
+        throw;
     }
+    flush();
 }
 
 void
@@ -37,42 +46,12 @@ Pl_LZWDecoder::finish()
 }
 
 void
-Pl_LZWDecoder::sendNextCode()
+Pl_LZWDecoder::flush()
 {
-    unsigned int high = this->byte_pos;
-    unsigned int med = (this->byte_pos + 1) % 3;
-    unsigned int low = (this->byte_pos + 2) % 3;
-
-    unsigned int bits_from_high = 8 - this->bit_pos;
-    unsigned int bits_from_med = this->code_size - bits_from_high;
-    unsigned int bits_from_low = 0;
-    if (bits_from_med > 8) {
-        bits_from_low = bits_from_med - 8;
-        bits_from_med = 8;
-    }
-    unsigned int high_mask = (1U << bits_from_high) - 1U;
-    unsigned int med_mask = 0xff - ((1U << (8 - bits_from_med)) - 1U);
-    unsigned int low_mask = 0xff - ((1U << (8 - bits_from_low)) - 1U);
-    unsigned int code = 0;
-    code += (this->buf[high] & high_mask) << bits_from_med;
-    code += ((this->buf[med] & med_mask) >> (8 - bits_from_med));
-    if (bits_from_low) {
-        code <<= bits_from_low;
-        code += ((this->buf[low] & low_mask) >> (8 - bits_from_low));
-        this->byte_pos = low;
-        this->bit_pos = bits_from_low;
-    } else {
-        this->byte_pos = med;
-        this->bit_pos = bits_from_med;
-    }
-    if (this->bit_pos == 8) {
-        this->bit_pos = 0;
-        ++this->byte_pos;
-        this->byte_pos %= 3;
+    if (!out.empty()) {
+        next()->write(out.data(), out.size());
+        out.clear();
     }
-    this->bits_available -= this->code_size;
-
-    handleCode(code);
 }
 
 unsigned char
@@ -86,8 +65,7 @@ Pl_LZWDecoder::getFirstChar(unsigned int code)
         if (idx >= table.size()) {
             throw std::runtime_error("Pl_LZWDecoder::getFirstChar: table overflow");
         }
-        Buffer& b = table.at(idx);
-        result = b.getBuffer()[0];
+        result = table[idx].first;
     } else {
         throw std::runtime_error(
             "Pl_LZWDecoder::getFirstChar called with invalid code (" + std::to_string(code) + ")");
@@ -98,33 +76,37 @@ Pl_LZWDecoder::getFirstChar(unsigned int code)
 void
 Pl_LZWDecoder::addToTable(unsigned char c)
 {
-    unsigned int last_size = 0;
-    unsigned char const* last_data = nullptr;
-    unsigned char tmp[1];
-
+    Entry entry{static_cast<unsigned short>(this->last_code), 2, 0, c};
     if (this->last_code < 256) {
-        tmp[0] = static_cast<unsigned char>(this->last_code);
-        last_data = tmp;
-        last_size = 1;
+        entry.first = static_cast<unsigned char>(this->last_code);
     } else if (this->last_code > 257) {
         unsigned int idx = this->last_code - 258;
         if (idx >= table.size()) {
             throw std::runtime_error("Pl_LZWDecoder::addToTable: table overflow");
         }
-        Buffer& b = table.at(idx);
-        last_data = b.getBuffer();
-        last_size = QIntC::to_uint(b.getSize());
+        entry.length = static_cast<unsigned short>(table[idx].length + 1);
+        entry.first = table[idx].first;
     } else {
         throw std::runtime_error(
             "Pl_LZWDecoder::addToTable called with invalid code (" +
             std::to_string(this->last_code) + ")");
     }
+    this->table.push_back(entry);
+}
 
-    Buffer entry(1 + last_size);
-    unsigned char* new_data = entry.getBuffer();
-    memcpy(new_data, last_data, last_size);
-    new_data[last_size] = c;
-    this->table.push_back(std::move(entry));
+void
+Pl_LZWDecoder::appendString(unsigned int code)
+{
+    // Fill in the string from its last character back.
+    size_t end = out.size() + table[code - 258].length;
+    out.resize(end);
+    unsigned char* p = out.data() + end;
+    while (code > 257) {
+        Entry const& entry = table[code - 258];
+        *--p = entry.suffix;
+        code = entry.prefix;
+    }
+    *--p = static_cast<unsigned char>(code);
 }
 
 void
@@ -176,15 +158,13 @@ Pl_LZWDecoder::handleCode(unsigned int code)
         }
 
         if (code < 256) {
-            auto ch = static_cast<unsigned char>(code);
-            next()->write(&ch, 1);
+            out.push_back(static_cast<unsigned char>(code));
         } else {
             unsigned int idx = code - 258;
             if (idx >= table.size()) {
                 throw std::runtime_error("Pl_LZWDecoder::handleCode: table overflow");
             }
-            Buffer& b = table.at(idx);
-            next()->write(b.getBuffer(), b.getSize());
+            appendString(code);
         }
     }
 
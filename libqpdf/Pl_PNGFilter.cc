@@ -2,7 +2,9 @@
 
 #include <qpdf/QTC.hh>
 #include <qpdf/QUtil.hh>
+#include <qpdf/sse2.hh>
 
+#include <algorithm>
 #include <climits>
 #include <cstring>
 #include <stdexcept>
@@ -10,6 +12,101 @@
 namespace
 {
     unsigned long long memory_limit{0};
+
+#ifdef QPDF_SSE2
+    // Load or store a pixel of up to 4 bytes in the low bytes of a vector.
+    __m128i
+    load_pixel(unsigned char const* p, unsigned int bpp)
+    {
+        int v = 0;
+        memcpy(&v, p, bpp);
+        return _mm_cvtsi32_si128(v);
+    }
+
+    void
+    store_pixel(unsigned char* p, __m128i v, unsigned int bpp)
+    {
+        int x = _mm_cvtsi128_si32(v);
+        memcpy(p, &x, bpp);
+    }
+
+    __m128i
+    select(__m128i mask, __m128i a, __m128i b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    // Add to each byte the bytes bpp, 2 * bpp, ... positions before it.
+    template <int bpp>
+    __m128i
+    prefix_sum(__m128i v)
+    {
+        v = _mm_add_epi8(v, _mm_slli_si128(v, bpp));
+        if constexpr (bpp < 8) {
+            v = _mm_add_epi8(v, _mm_slli_si128(v, 2 * bpp));
+        }
+        if constexpr (bpp < 4) {
+            v = _mm_add_epi8(v, _mm_slli_si128(v, 4 * bpp));
+        }
+        if constexpr (bpp < 2) {
+            v = _mm_add_epi8(v, _mm_slli_si128(v, 8 * bpp));
+        }
+        return v;
+    }
+
+    // Decode the Sub filter for a bpp that divides 16, 16 bytes at a time. After the prefix sum
+    // within a block, the last pixel of the previous block is added to every pixel. Return the
+    // number of bytes decoded.
+    template <int bpp>
+    unsigned int
+    decode_sub(unsigned char* buffer, unsigned int n)
+    {
+        __m128i carry = _mm_setzero_si128();
+        unsigned int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            auto p = reinterpret_cast<__m128i*>(buffer + i);
+            auto v = _mm_add_epi8(prefix_sum<bpp>(_mm_loadu_si128(p)), carry);
+            _mm_storeu_si128(p, v);
+            carry = prefix_sum<bpp>(_mm_srli_si128(v, 16 - bpp));
+        }
+        return i;
+    }
+
+    // The Paeth filter depends on the decoded pixel to the left, so it is decoded a pixel at a
+    // time with all bytes of the pixel in one vector. This is used for 3 and 4 byte pixels. Return
+    // the number of bytes decoded.
+    unsigned int
+    decode_paeth(
+        unsigned char* buffer, unsigned char const* above, unsigned int n, unsigned int bpp)
+    {
+        // Work with 16-bit lanes so that the differences don't overflow.
+        auto const zero = _mm_setzero_si128();
+        auto const low_byte = _mm_set1_epi16(0xff);
+        auto abs = [zero](__m128i v) { return _mm_max_epi16(v, _mm_sub_epi16(zero, v)); };
+        auto left = zero;
+        auto upper_left = zero;
+        unsigned int i = 0;
+        for (; i + bpp <= n; i += bpp) {
+            auto up = _mm_unpacklo_epi8(load_pixel(above + i, bpp), zero);
+            // With p = left + up - upper_left, these are p - left, p - up and p - upper_left.
+            auto pa = _mm_sub_epi16(up, upper_left);
+            auto pb = _mm_sub_epi16(left, upper_left);
+            auto pc = abs(_mm_add_epi16(pa, pb));
+            pa = abs(pa);
+            pb = abs(pb);
+            auto smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+            auto predictor = select(
+                _mm_cmpeq_epi16(smallest, pa),
+                left,
+                select(_mm_cmpeq_epi16(smallest, pb), up, upper_left));
+            auto current = _mm_unpacklo_epi8(load_pixel(buffer + i, bpp), zero);
+            left = _mm_and_si128(_mm_add_epi16(current, predictor), low_byte);
+            store_pixel(buffer + i, _mm_packus_epi16(left, left), bpp);
+            upper_left = up;
+        }
+        return i;
+    }
+#endif
 } // namespace
 
 static int
@@ -54,6 +151,9 @@ Pl_PNGFilter::Pl_PNGFilter(
     memset(this->buf2.get(), 0, this->bytes_per_row + 1);
     this->cur_row = this->buf1.get();
     this->prev_row = this->buf2.get();
+    if (action == a_encode) {
+        this->buf3 = QUtil::make_shared_array<unsigned char>(this->bytes_per_row + 1);
+    }
 
     // number of bytes per incoming row
     this->incoming = (action == a_encode ? this->bytes_per_row : this->bytes_per_row + 1);
@@ -138,14 +238,28 @@ Pl_PNGFilter::decodeSub()
     unsigned char* buffer = this->cur_row + 1;
     unsigned int bpp = this->bytes_per_pixel;
 
-    for (unsigned int i = 0; i < this->bytes_per_row; ++i) {
-        unsigned char left = 0;
-
-        if (i >= bpp) {
-            left = buffer[i - bpp];
-        }
-
-        buffer[i] = static_cast<unsigned char>(buffer[i] + left);
+    unsigned int i = 0;
+#ifdef QPDF_SSE2
+    switch (bpp) {
+    case 1:
+        i = decode_sub<1>(buffer, this->bytes_per_row);
+        break;
+    case 2:
+        i = decode_sub<2>(buffer, this->bytes_per_row);
+        break;
+    case 4:
+        i = decode_sub<4>(buffer, this->bytes_per_row);
+        break;
+    case 8:
+        i = decode_sub<8>(buffer, this->bytes_per_row);
+        break;
+    default:
+        break;
+    }
+#endif
+    // The first pixel has nothing to its left.
+    for (i = std::max(i, bpp); i < this->bytes_per_row; ++i) {
+        buffer[i] = static_cast<unsigned char>(buffer[i] + buffer[i - bpp]);
     }
 }
 
@@ -156,9 +270,16 @@ Pl_PNGFilter::decodeUp()
     unsigned char* buffer = this->cur_row + 1;
     unsigned char* above_buffer = this->prev_row + 1;
 
-    for (unsigned int i = 0; i < this->bytes_per_row; ++i) {
-        unsigned char up = above_buffer[i];
-        buffer[i] = static_cast<unsigned char>(buffer[i] + up);
+    unsigned int i = 0;
+#ifdef QPDF_SSE2
+    for (; i + 16 <= this->bytes_per_row; i += 16) {
+        auto p = reinterpret_cast<__m128i*>(buffer + i);
+        auto up = _mm_loadu_si128(reinterpret_cast<__m128i const*>(above_buffer + i));
+        _mm_storeu_si128(p, _mm_add_epi8(_mm_loadu_si128(p), up));
+    }
+#endif
+    for (; i < this->bytes_per_row; ++i) {
+        buffer[i] = static_cast<unsigned char>(buffer[i] + above_buffer[i]);
     }
 }
 
@@ -170,15 +291,14 @@ Pl_PNGFilter::decodeAverage()
     unsigned char* above_buffer = this->prev_row + 1;
     unsigned int bpp = this->bytes_per_pixel;
 
-    for (unsigned int i = 0; i < this->bytes_per_row; ++i) {
-        int left = 0;
-        int up = 0;
-
-        if (i >= bpp) {
-            left = buffer[i - bpp];
-        }
-
-        up = above_buffer[i];
+    // With nothing to the left, the predictor is half the byte above.
+    unsigned int i = 0;
+    for (; i < std::min(bpp, this->bytes_per_row); ++i) {
+        buffer[i] = static_cast<unsigned char>(buffer[i] + above_buffer[i] / 2);
+    }
+    for (; i < this->bytes_per_row; ++i) {
+        int left = buffer[i - bpp];
+        int up = above_buffer[i];
         buffer[i] = static_cast<unsigned char>(buffer[i] + (left + up) / 2);
     }
 }
@@ -191,16 +311,20 @@ Pl_PNGFilter::decodePaeth()
     unsigned char* above_buffer = this->prev_row + 1;
     unsigned int bpp = this->bytes_per_pixel;
 
-    for (unsigned int i = 0; i < this->bytes_per_row; ++i) {
-        int left = 0;
+    unsigned int i = 0;
+#ifdef QPDF_SSE2
+    if (bpp == 3 || bpp == 4) {
+        i = decode_paeth(buffer, above_buffer, this->bytes_per_row, bpp);
+    }
+#endif
+    // With nothing to the left, the predictor is always the byte above.
+    for (; i < std::min(bpp, this->bytes_per_row); ++i) {
+        buffer[i] = static_cast<unsigned char>(buffer[i] + above_buffer[i]);
+    }
+    for (; i < this->bytes_per_row; ++i) {
+        int left = buffer[i - bpp];
         int up = above_buffer[i];
-        int upper_left = 0;
-
-        if (i >= bpp) {
-            left = buffer[i - bpp];
-            upper_left = above_buffer[i - bpp];
-        }
-
+        int upper_left = above_buffer[i - bpp];
         buffer[i] =
             static_cast<unsigned char>(buffer[i] + this->PaethPredictor(left, up, upper_left));
     }
@@ -226,17 +350,18 @@ Pl_PNGFilter::PaethPredictor(int a, int b, int c)
 void
 Pl_PNGFilter::encodeRow()
 {
-    // For now, hard-code to using UP filter.
-    unsigned char ch = 2;
-    next()->write(&ch, 1);
+    // For now, hard-code to using UP filter. Write the row in one piece rather than a byte at a
+    // time.
+    unsigned char* out = this->buf3.get();
+    out[0] = 2;
     if (this->prev_row) {
         for (unsigned int i = 0; i < this->bytes_per_row; ++i) {
-            ch = static_cast<unsigned char>(this->cur_row[i] - this->prev_row[i]);
-            next()->write(&ch, 1);
+            out[i + 1] = static_cast<unsigned char>(this->cur_row[i] - this->prev_row[i]);
         }
     } else {
-        next()->write(this->cur_row, this->bytes_per_row);
+        memcpy(out + 1, this->cur_row, this->bytes_per_row);
     }
+    next()->write(out, this->bytes_per_row + 1);
 }
 
 void
@@ -10,6 +10,80 @@
 namespace
 {
     unsigned long long memory_limit{0};
+
+    // Read or write a big-endian sample of bytes_per_sample bytes.
+    template <unsigned int bytes_per_sample>
+    unsigned int
+    get_sample(unsigned char const* p)
+    {
+        if constexpr (bytes_per_sample == 1) {
+            return p[0];
+        } else {
+            return (static_cast<unsigned int>(p[0]) << 8) | p[1];
+        }
+    }
+
+    template <unsigned int bytes_per_sample>
+    void
+    set_sample(unsigned char* p, unsigned int sample)
+    {
+        if constexpr (bytes_per_sample == 1) {
+            p[0] = static_cast<unsigned char>(sample);
+        } else {
+            p[0] = static_cast<unsigned char>(sample >> 8);
+            p[1] = static_cast<unsigned char>(sample);
+        }
+    }
+
+    // Apply or undo the predictor in place on a row of 8 or 16 bit samples. spp is the number of
+    // samples per pixel, or 0 if it is only known at runtime, in which case it is passed in
+    // runtime_spp. The first pixel is unchanged. When encoding, go from the end of the row so that
+    // each sample is subtracted from before it is changed.
+    template <unsigned int bytes_per_sample, unsigned int spp>
+    void
+    predict_row(unsigned char* row, size_t size, unsigned int runtime_spp, bool decode)
+    {
+        size_t const stride = bytes_per_sample * (spp ? spp : runtime_spp);
+        if (decode) {
+            for (size_t i = stride; i + bytes_per_sample <= size; i += bytes_per_sample) {
+                set_sample<bytes_per_sample>(
+                    row + i,
+                    get_sample<bytes_per_sample>(row + i) +
+                        get_sample<bytes_per_sample>(row + i - stride));
+            }
+        } else {
+            for (size_t i = size - size % bytes_per_sample; i >= stride + bytes_per_sample;) {
+                i -= bytes_per_sample;
+                set_sample<bytes_per_sample>(
+                    row + i,
+                    get_sample<bytes_per_sample>(row + i) -
+                        get_sample<bytes_per_sample>(row + i - stride));
+            }
+        }
+    }
+
+    template <unsigned int bytes_per_sample>
+    void
+    predict_row(unsigned char* row, size_t size, unsigned int spp, bool decode)
+    {
+        switch (spp) {
+        case 1:
+            predict_row<bytes_per_sample, 1>(row, size, spp, decode);
+            break;
+        case 2:
+            predict_row<bytes_per_sample, 2>(row, size, spp, decode);
+            break;
+        case 3:
+            predict_row<bytes_per_sample, 3>(row, size, spp, decode);
+            break;
+        case 4:
+            predict_row<bytes_per_sample, 4>(row, size, spp, decode);
+            break;
+        default:
+            predict_row<bytes_per_sample, 0>(row, size, spp, decode);
+            break;
+        }
+    }
 } // namespace
 
 Pl_TIFFPredictor::Pl_TIFFPredictor(
@@ -75,7 +149,7 @@ Pl_TIFFPredictor::processRow()
 {
     QTC::TC("libtests", "Pl_TIFFPredictor processRow", (action == a_decode ? 0 : 1));
     previous.assign(samples_per_pixel, 0);
-    if (bits_per_sample != 8) {
+    if (bits_per_sample != 8 && bits_per_sample != 16) {
         BitWriter bw(next());
         BitStream in(cur_row.data(), cur_row.size());
         for (unsigned int col = 0; col < this->columns; ++col) {
@@ -94,27 +168,15 @@ Pl_TIFFPredictor::processRow()
         }
         bw.flush();
     } else {
-        out.clear();
-        auto next_it = cur_row.begin();
-        auto cr_end = cur_row.end();
-        auto pr_end = previous.end();
-
-        while (next_it != cr_end) {
-            for (auto prev = previous.begin(); prev != pr_end && next_it != cr_end;
-                 ++prev, ++next_it) {
-                long long sample = *next_it;
-                long long new_sample = sample;
-                if (action == a_encode) {
-                    new_sample -= *prev;
-                    *prev = sample;
-                } else {
-                    new_sample += *prev;
-                    *prev = new_sample;
-                }
-                out.push_back(static_cast<unsigned char>(255U & new_sample));
-            }
+        // Whole-byte samples are the common case. Work on them in place rather than through
+        // BitStream and BitWriter.
+        bool decode = action == a_decode;
+        if (bits_per_sample == 8) {
+            predict_row<1>(cur_row.data(), cur_row.size(), samples_per_pixel, decode);
+        } else {
+            predict_row<2>(cur_row.data(), cur_row.size(), samples_per_pixel, decode);
         }
-        next()->write(out.data(), out.size());
+        next()->write(cur_row.data(), cur_row.size());
     }
 }
 
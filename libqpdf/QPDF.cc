@@ -2,21 +2,25 @@
 
 #include <qpdf/QPDF_private.hh>
 
+#include <algorithm>
 #include <atomic>
 #include <cstring>
 #include <map>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
 #include <qpdf/BufferInputSource.hh>
 #include <qpdf/FileInputSource.hh>
+#include <qpdf/MmapInputSource.hh>
 #include <qpdf/OffsetInputSource.hh>
 #include <qpdf/Pipeline.hh>
 #include <qpdf/QPDFExc.hh>
 #include <qpdf/QPDFLogger.hh>
 #include <qpdf/QPDFObject_private.hh>
 #include <qpdf/QPDFParser.hh>
+#include <qpdf/QPDFSystemError.hh>
 #include <qpdf/QPDF_Array.hh>
 #include <qpdf/QPDF_Dictionary.hh>
 #include <qpdf/QPDF_Null.hh>
@@ -210,8 +214,20 @@ QPDF::create()
 void
 QPDF::processFile(char const* filename, char const* password)
 {
-    auto* fi = new FileInputSource(filename);
-    processInputSource(std::shared_ptr<InputSource>(fi), password);
+    std::shared_ptr<InputSource> is;
+    if (m->use_mmap) {
+        try {
+            is = std::make_shared<MmapInputSource>(filename);
+        } catch (QPDFSystemError&) {
+            // Not every file can be mapped (e.g. pipes); read it normally instead.
+        } catch (std::range_error&) {
+            // The file is too large to be mapped into the address space.
+        }
+    }
+    if (!is) {
+        is = std::make_shared<FileInputSource>(filename);
+    }
+    processInputSource(is, password);
 }
 
 void
@@ -314,6 +330,24 @@ QPDF::setAttemptRecovery(bool val)
     m->objects.xref_table().attempt_recovery(val);
 }
 
+void
+QPDF::setUseMmap(bool val)
+{
+    m->use_mmap = val;
+}
+
+void
+QPDF::setLazyParsing(bool val)
+{
+    m->lazy_parsing = val;
+}
+
+void
+QPDF::setRecoveryThreads(int n)
+{
+    m->recovery_threads = n < 1 ? 1 : n;
+}
+
 void
 QPDF::setImmediateCopyFrom(bool val)
 {
@@ -428,6 +462,9 @@ QPDF::inParse(bool v)
 void
 QPDF::warn(QPDFExc const& e)
 {
+    if (m->mute_warnings) {
+        return;
+    }
     if (m->max_warnings > 0 && m->warnings.size() >= m->max_warnings) {
         stopOnError("Too many warnings - file is too badly damaged");
     }
@@ -483,6 +520,12 @@ QPDF::getAllObjects()
     return m->objects.all();
 }
 
+void
+QPDF::preloadObjectStreams(int n_threads)
+{
+    m->objects.preload_object_streams(n_threads < 1 ? 1 : static_cast<size_t>(n_threads));
+}
+
 void
 QPDF::setLastObjectDescription(std::string const& description, QPDFObjGen const& og)
 {
@@ -853,7 +896,7 @@ QPDF::copyStreamData(QPDFObjectHandle result, QPDFObjectHandle foreign)
             foreign_stream_qpdf.m->encp,
             foreign_stream_qpdf.m->file_sp,
             foreign.getObjGen(),
-            stream->getParsedOffset(),
+            foreign.getObjectPtr()->getParsedOffset(),
             stream->getLength(),
             dict);
         m->copied_stream_data_provider->registerForeignStream(local_og, foreign_stream_data);
@@ -960,6 +1003,17 @@ QPDF::getXRefTable()
     return m->objects.xref_table().as_map();
 }
 
+void
+QPDF::forEachXRefEntry(std::function<void(QPDFObjGen, QPDFXRefEntry const&)> fn)
+{
+    if (!m->objects.xref_table().initialized()) {
+        throw std::logic_error("QPDF::forEachXRefEntry called before parsing.");
+    }
+    for (auto const& [og, entry]: m->objects.xref_table()) {
+        fn(og, entry);
+    }
+}
+
 bool
 QPDF::pipeStreamData(
     std::shared_ptr<EncryptionParameters> encp,
@@ -980,12 +1034,25 @@ QPDF::pipeStreamData(
 
     bool attempted_finish = false;
     try {
-        file->seek(offset, SEEK_SET);
-        auto buf = std::make_unique<char[]>(length);
-        if (auto read = file->read(buf.get(), length); read != length) {
-            throw damagedPDF(*file, "", offset + toO(read), "unexpected EOF reading stream data");
+        bool complete = false;
+        if (length > 65536) {
+            // If all the data is present, pass it on in pieces rather than holding the whole stream
+            // in memory.
+            char last;
+            file->seek(offset + toO(length) - 1, SEEK_SET);
+            complete = (file->read(&last, 1) == 1);
+        }
+        if (complete) {
+            pipeRawStreamData(*file, offset, length, pipeline);
+        } else {
+            file->seek(offset, SEEK_SET);
+            auto buf = std::make_unique<char[]>(length);
+            if (auto read = file->read(buf.get(), length); read != length) {
+                throw damagedPDF(
+                    *file, "", offset + toO(read), "unexpected EOF reading stream data");
+            }
+            pipeline->write(buf.get(), length);
         }
-        pipeline->write(buf.get(), length);
         attempted_finish = true;
         pipeline->finish();
         return true;
@@ -1048,6 +1115,46 @@ QPDF::pipeStreamData(
         will_retry);
 }
 
+bool
+QPDF::getRawStreamDataRange(QPDFObjectHandle& stream, qpdf_offset_t& offset, size_t& length)
+{
+    // Find the location of a stream's data in the input file if it can be copied to the output
+    // exactly as it is. This requires the data to be unencrypted, unmodified, and entirely within
+    // the file, so that pipeRawStreamData can't fail after it has started writing.
+    if (m->encp->encrypted || (stream.getOwningQPDF() != this)) {
+        return false;
+    }
+    auto s = stream.getObjectPtr()->as<QPDF_Stream>();
+    if (!(s && s->getInputDataRange(offset, length))) {
+        return false;
+    }
+    if (length > 0) {
+        char ch;
+        m->file->seek(offset + toO(length) - 1, SEEK_SET);
+        if (m->file->read(&ch, 1) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+QPDF::pipeRawStreamData(InputSource& file, qpdf_offset_t offset, size_t length, Pipeline* pipeline)
+{
+    // Copy in pieces so that large streams are never held in memory. Unlike pipeStreamData, this
+    // does not call finish on the pipeline.
+    char buf[65536];
+    file.seek(offset, SEEK_SET);
+    while (length > 0) {
+        size_t len = file.read(buf, std::min(length, sizeof(buf)));
+        if (len == 0) {
+            throw damagedPDF(file, "", file.getLastOffset(), "unexpected EOF reading stream data");
+        }
+        pipeline->write(buf, len);
+        length -= len;
+    }
+}
+
 bool
 QPDF::pipeForeignStreamData(
     std::shared_ptr<ForeignStreamData> foreign,
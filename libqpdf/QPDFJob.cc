@@ -1,11 +1,13 @@
 #include <qpdf/QPDFJob.hh>
 
 #include <cstring>
+#include <deque>
 #include <iostream>
 #include <memory>
 
 #include <qpdf/ClosedFileInputSource.hh>
 #include <qpdf/FileInputSource.hh>
+#include <qpdf/MmapInputSource.hh>
 #include <qpdf/Pl_Count.hh>
 #include <qpdf/Pl_DCT.hh>
 #include <qpdf/Pl_Discard.hh>
@@ -28,6 +30,7 @@
 #include <qpdf/QPDF_private.hh>
 #include <qpdf/QTC.hh>
 #include <qpdf/QUtil.hh>
+#include <qpdf/WorkerPool.hh>
 
 #include <qpdf/auto_job_schema.hh> // JOB_SCHEMA_DATA
 
@@ -669,6 +672,15 @@ QPDFJob::setQPDFOptions(QPDF& pdf)
     if (m->ignore_xref_streams) {
         pdf.setIgnoreXRefStreams(true);
     }
+    if (m->use_mmap) {
+        pdf.setUseMmap(true);
+    }
+    if (m->lazy_parsing) {
+        pdf.setLazyParsing(true);
+    }
+    if (m->recovery_threads > 1) {
+        pdf.setRecoveryThreads(m->recovery_threads);
+    }
     if (m->suppress_recovery) {
         pdf.setAttemptRecovery(false);
     }
@@ -1727,6 +1739,9 @@ QPDFJob::doProcessOnce(
         pdf->createFromJSON(m->infilename.get());
     } else {
         fn(pdf.get(), password);
+        if (main_input && m->preload_object_streams > 0) {
+            pdf->preloadObjectStreams(m->preload_object_streams);
+        }
     }
     if (used_for_input) {
         m->max_input_version.updateIfGreater(pdf->getVersionAsPDFVersion());
@@ -2438,8 +2453,17 @@ QPDFJob::handlePageSpecs(QPDF& pdf, std::vector<std::unique_ptr<QPDF>>& page_hea
                 cis->stayOpen(true);
             } else {
                 QTC::TC("qpdf", "QPDFJob keep files open y");
-                FileInputSource* fis = new FileInputSource(page_spec.filename.c_str());
-                is = std::shared_ptr<InputSource>(fis);
+                if (m->use_mmap) {
+                    try {
+                        is = std::make_shared<MmapInputSource>(page_spec.filename.c_str());
+                    } catch (QPDFSystemError&) {
+                        // fall back to FileInputSource
+                    }
+                }
+                if (!is) {
+                    FileInputSource* fis = new FileInputSource(page_spec.filename.c_str());
+                    is = std::shared_ptr<InputSource>(fis);
+                }
             }
             std::unique_ptr<QPDF> qpdf_sp;
             processInputSource(qpdf_sp, is, password, true);
@@ -2876,6 +2900,24 @@ QPDFJob::setWriterOptions(QPDFWriter& w)
     if (m->newline_before_endstream) {
         w.setNewlineBeforeEndstream(true);
     }
+    if (m->indirect_stream_lengths) {
+        w.setIndirectStreamLengths(true);
+    }
+    if (m->release_written_objects) {
+        w.setReleaseWrittenObjects(true);
+    }
+    if (m->linearization_cache_size > 0) {
+        w.setLinearizationCacheSize(m->linearization_cache_size);
+    }
+    if (m->linearization_cache_file) {
+        w.setLinearizationCacheFile(true);
+    }
+    if (m->report_linearization_times) {
+        w.registerLinearizationTimer([this](std::string const& phase, double seconds) {
+            *m->log->getWarn() << "qpdf-linearization-time " << phase << ": "
+                               << QUtil::double_to_string(seconds, 3, false) << "\n";
+        });
+    }
     if (m->normalize_set) {
         w.setContentNormalization(m->normalize);
     }
@@ -2888,6 +2930,9 @@ QPDFJob::setWriterOptions(QPDFWriter& w)
     if (m->recompress_flate_set) {
         w.setRecompressFlate(m->recompress_flate);
     }
+    if (m->compression_threads > 1) {
+        w.setCompressionThreads(m->compression_threads);
+    }
     if (m->decode_level_set) {
         w.setDecodeLevel(m->decode_level);
     }
@@ -2985,13 +3030,63 @@ QPDFJob::doSplitPages(QPDF& pdf)
     std::vector<QPDFObjectHandle> const& pages = pdf.getAllPages();
     size_t pageno_len = std::to_string(pages.size()).length();
     size_t num_pages = pages.size();
+
+    // With --jobs, the output files are still assembled on this thread because the input can't be
+    // used from more than one thread, but they are written by a pool of workers. Immediate copy
+    // makes each output QPDF hold its own copy of the stream data, so writing it never reads from
+    // the input. Output files are finished in order so messages appear as they would otherwise.
+    // Progress reporting and the linearization pass 1 file are shared by all outputs, so they
+    // disable this.
+    struct SplitOutput
+    {
+        std::string outfile;
+        std::string warnings;
+        std::unique_ptr<QPDF> pdf;
+        std::unique_ptr<QPDFWriter> w;
+        std::future<void> written;
+    };
+    std::deque<SplitOutput> pending;
+    std::unique_ptr<WorkerPool> pool;
+    if ((m->jobs > 1) && (num_pages > QIntC::to_size(m->split_pages)) && (!m->progress) &&
+        m->linearize_pass1.empty()) {
+        QTC::TC("qpdf", "QPDFJob split-pages parallel");
+        pool = std::make_unique<WorkerPool>(QIntC::to_size(m->jobs));
+        pdf.setImmediateCopyFrom(true);
+    }
+    auto finish_output = [this, &pending]() {
+        auto& output = pending.front();
+        output.written.get();
+        if (!output.warnings.empty()) {
+            *m->log->getWarn() << output.warnings;
+        }
+        doIfVerbose([&](Pipeline& v, std::string const& prefix) {
+            v << prefix << ": wrote file " << output.outfile << "\n";
+        });
+        pending.pop_front();
+    };
+
     for (size_t i = 0; i < num_pages; i += QIntC::to_size(m->split_pages)) {
         size_t first = i + 1;
         size_t last = i + QIntC::to_size(m->split_pages);
         if (last > num_pages) {
             last = num_pages;
         }
-        QPDF outpdf;
+        SplitOutput* output = nullptr;
+        std::unique_ptr<QPDF> outpdf_ph;
+        if (pool) {
+            if (pending.size() >= 2 * pool->size()) {
+                finish_output();
+            }
+            output = &pending.emplace_back();
+            output->pdf = std::make_unique<QPDF>();
+            auto log = QPDFLogger::create();
+            log->setWarn(
+                std::make_shared<Pl_String>("split pages warnings", nullptr, output->warnings));
+            output->pdf->setLogger(log);
+        } else {
+            outpdf_ph = std::make_unique<QPDF>();
+        }
+        QPDF& outpdf = output ? *output->pdf : *outpdf_ph;
         outpdf.emptyPDF();
         std::shared_ptr<QPDFAcroFormDocumentHelper> out_afdh;
         if (afdh.hasAcroForm()) {
@@ -3035,12 +3130,21 @@ QPDFJob::doSplitPages(QPDF& pdf)
         if (QUtil::same_file(m->infilename.get(), outfile.c_str())) {
             throw std::runtime_error("split pages would overwrite input file with " + outfile);
         }
-        QPDFWriter w(outpdf, outfile.c_str());
-        setWriterOptions(w);
-        w.write();
-        doIfVerbose([&](Pipeline& v, std::string const& prefix) {
-            v << prefix << ": wrote file " << outfile << "\n";
-        });
+        auto w = std::make_unique<QPDFWriter>(outpdf, outfile.c_str());
+        setWriterOptions(*w);
+        if (!pool) {
+            w->write();
+            doIfVerbose([&](Pipeline& v, std::string const& prefix) {
+                v << prefix << ": wrote file " << outfile << "\n";
+            });
+            continue;
+        }
+        output->outfile = outfile;
+        output->w = std::move(w);
+        output->written = pool->submit([output]() { output->w->write(); });
+    }
+    while (!pending.empty()) {
+        finish_output();
     }
 }
 
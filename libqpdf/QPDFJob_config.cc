@@ -139,6 +139,16 @@ QPDFJob::Config::compressionLevel(std::string const& parameter)
     return this;
 }
 
+QPDFJob::Config*
+QPDFJob::Config::compressionThreads(std::string const& parameter)
+{
+    o.m->compression_threads = QUtil::string_to_int(parameter.c_str());
+    if (o.m->compression_threads < 0) {
+        usage("--compression-threads must be a non-negative number");
+    }
+    return this;
+}
+
 QPDFJob::Config*
 QPDFJob::Config::copyEncryption(std::string const& parameter)
 {
@@ -235,6 +245,13 @@ QPDFJob::Config::iiMinBytes(std::string const& parameter)
     return this;
 }
 
+QPDFJob::Config*
+QPDFJob::Config::indirectStreamLengths()
+{
+    o.m->indirect_stream_lengths = true;
+    return this;
+}
+
 QPDFJob::Config*
 QPDFJob::Config::isEncrypted()
 {
@@ -243,6 +260,16 @@ QPDFJob::Config::isEncrypted()
     return this;
 }
 
+QPDFJob::Config*
+QPDFJob::Config::jobs(std::string const& parameter)
+{
+    o.m->jobs = QUtil::string_to_int(parameter.c_str());
+    if (o.m->jobs < 1) {
+        usage("--jobs must be a positive number");
+    }
+    return this;
+}
+
 QPDFJob::Config*
 QPDFJob::Config::json()
 {
@@ -360,6 +387,27 @@ QPDFJob::Config::keepInlineImages()
     return this;
 }
 
+QPDFJob::Config*
+QPDFJob::Config::lazyParsing()
+{
+    o.m->lazy_parsing = true;
+    return this;
+}
+
+QPDFJob::Config*
+QPDFJob::Config::linearizationCacheFile()
+{
+    o.m->linearization_cache_file = true;
+    return this;
+}
+
+QPDFJob::Config*
+QPDFJob::Config::linearizationCacheSize(std::string const& parameter)
+{
+    o.m->linearization_cache_size = QIntC::to_size(QUtil::string_to_ull(parameter.c_str()));
+    return this;
+}
+
 QPDFJob::Config*
 QPDFJob::Config::linearize()
 {
@@ -389,6 +437,13 @@ QPDFJob::Config::minVersion(std::string const& parameter)
     return this;
 }
 
+QPDFJob::Config*
+QPDFJob::Config::mmap()
+{
+    o.m->use_mmap = true;
+    return this;
+}
+
 QPDFJob::Config*
 QPDFJob::Config::newlineBeforeEndstream()
 {
@@ -460,6 +515,16 @@ QPDFJob::Config::passwordIsHexKey()
     return this;
 }
 
+QPDFJob::Config*
+QPDFJob::Config::preloadObjectStreams(std::string const& parameter)
+{
+    o.m->preload_object_streams = QUtil::string_to_int(parameter.c_str());
+    if (o.m->preload_object_streams < 1) {
+        usage("--preload-object-streams must be a positive number");
+    }
+    return this;
+}
+
 QPDFJob::Config*
 QPDFJob::Config::preserveUnreferenced()
 {
@@ -503,6 +568,23 @@ QPDFJob::Config::recompressFlate()
     return this;
 }
 
+QPDFJob::Config*
+QPDFJob::Config::recoveryThreads(std::string const& parameter)
+{
+    o.m->recovery_threads = QUtil::string_to_int(parameter.c_str());
+    if (o.m->recovery_threads < 1) {
+        usage("--recovery-threads must be a positive number");
+    }
+    return this;
+}
+
+QPDFJob::Config*
+QPDFJob::Config::releaseWrittenObjects()
+{
+    o.m->release_written_objects = true;
+    return this;
+}
+
 QPDFJob::Config*
 QPDFJob::Config::removeAttachment(std::string const& parameter)
 {
@@ -531,6 +613,13 @@ QPDFJob::Config::removePageLabels()
     return this;
 }
 
+QPDFJob::Config*
+QPDFJob::Config::reportLinearizationTimes()
+{
+    o.m->report_linearization_times = true;
+    return this;
+}
+
 QPDFJob::Config*
 QPDFJob::Config::reportMemoryUsage()
 {
@@ -1,10 +1,216 @@
 #include <qpdf/QPDFObject_private.hh>
 
 #include <qpdf/QPDF.hh>
-#include <qpdf/QPDF_Destroyed.hh>
+
+#include <stdexcept>
+
+namespace
+{
+    template <qpdf_object_type_e type_code, typename T>
+    constexpr bool holds =
+        std::is_same_v<std::variant_alternative_t<type_code, QPDFObject::Value>, T>;
+} // namespace
+
+static_assert(
+    holds<::ot_reserved, QPDF_Reserved> && holds<::ot_null, QPDF_Null> &&
+    holds<::ot_boolean, QPDF_Bool> && holds<::ot_integer, QPDF_Integer> &&
+    holds<::ot_real, QPDF_Real> && holds<::ot_string, QPDF_String> &&
+    holds<::ot_name, QPDF_Name> && holds<::ot_array, QPDF_Array> &&
+    holds<::ot_dictionary, QPDF_Dictionary> && holds<::ot_stream, QPDF_Stream> &&
+    holds<::ot_operator, QPDF_Operator> && holds<::ot_inlineimage, QPDF_InlineImage> &&
+    holds<::ot_unresolved, QPDF_Unresolved> && holds<::ot_destroyed, QPDF_Destroyed>);
+
+std::shared_ptr<QPDFObject>
+QPDFObject::copy(bool shallow)
+{
+    return std::visit(
+        [this, shallow](auto& value) -> std::shared_ptr<QPDFObject> {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::monostate>) {
+                throw std::logic_error("attempted to copy an uninitialized QPDFObject");
+            } else if constexpr (std::is_same_v<T, QPDF_Unresolved>) {
+                return QPDF::Resolver::resolved(qpdf, og)->copy(shallow);
+            } else if constexpr (std::is_same_v<T, QPDF_Reference>) {
+                return value.obj->copy(shallow);
+            } else if constexpr (std::is_same_v<T, QPDF_Deferred>) {
+                parseDeferred();
+                return copy(shallow);
+            } else {
+                return value.copy(shallow);
+            }
+        },
+        value);
+}
+
+std::string
+QPDFObject::unparse()
+{
+    return std::visit(
+        [this](auto& value) -> std::string {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::monostate>) {
+                throw std::logic_error("attempted to unparse an uninitialized QPDFObject");
+            } else if constexpr (std::is_same_v<T, QPDF_Unresolved>) {
+                return QPDF::Resolver::resolved(qpdf, og)->unparse();
+            } else if constexpr (std::is_same_v<T, QPDF_Reference>) {
+                return value.obj->unparse();
+            } else if constexpr (std::is_same_v<T, QPDF_Deferred>) {
+                parseDeferred();
+                return unparse();
+            } else {
+                return value.unparse();
+            }
+        },
+        value);
+}
+
+void
+QPDFObject::writeJSON(int json_version, JSON::Writer& p)
+{
+    std::visit(
+        [this, json_version, &p](auto& value) {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::monostate>) {
+                throw std::logic_error("attempted to get JSON from an uninitialized QPDFObject");
+            } else if constexpr (std::is_same_v<T, QPDF_Unresolved>) {
+                QPDF::Resolver::resolved(qpdf, og)->writeJSON(json_version, p);
+            } else if constexpr (std::is_same_v<T, QPDF_Reference>) {
+                value.obj->writeJSON(json_version, p);
+            } else if constexpr (std::is_same_v<T, QPDF_Deferred>) {
+                parseDeferred();
+                writeJSON(json_version, p);
+            } else {
+                value.writeJSON(json_version, p);
+            }
+        },
+        value);
+}
+
+std::string
+QPDFObject::getStringValue() const
+{
+    switch (value.index()) {
+    case ::ot_real:
+        return std::get<QPDF_Real>(value).getStringValue();
+    case ::ot_string:
+        return std::get<QPDF_String>(value).getStringValue();
+    case ::ot_name:
+        return std::get<QPDF_Name>(value).getStringValue();
+    case ::ot_operator:
+        return std::get<QPDF_Operator>(value).getStringValue();
+    case ::ot_inlineimage:
+        return std::get<QPDF_InlineImage>(value).getStringValue();
+    case ::ot_unresolved:
+        return QPDF::Resolver::resolved(qpdf, og)->getStringValue();
+    default:
+        if (auto ref = reference()) {
+            return ref->getStringValue();
+        }
+        return "";
+    }
+}
+
+std::string
+QPDFObject::getDescription()
+{
+    if (auto ref = reference()) {
+        return ref->getDescription();
+    }
+    if (object_description) {
+        switch (object_description->index()) {
+        case 0:
+            {
+                // Simple template string
+                auto description = std::get<0>(*object_description);
+
+                if (auto pos = description.find("$OG"); pos != std::string::npos) {
+                    description.replace(pos, 3, og.unparse(' '));
+                }
+                if (auto pos = description.find("$PO"); pos != std::string::npos) {
+                    auto type_code = getTypeCode();
+                    qpdf_offset_t shift = (type_code == ::ot_dictionary) ? 2
+                        : (type_code == ::ot_array)                      ? 1
+                                                                         : 0;
+
+                    description.replace(pos, 3, std::to_string(parsed_offset + shift));
+                }
+                return description;
+            }
+        case 1:
+            {
+                // QPDF::JSONReactor generated description
+                auto j_descr = std::get<1>(*object_description);
+                return (
+                    *j_descr.input + (j_descr.object.empty() ? "" : ", " + j_descr.object) +
+                    " at offset " + std::to_string(parsed_offset));
+            }
+        case 2:
+            {
+                // Child object description
+                auto j_descr = std::get<2>(*object_description);
+                std::string result;
+                if (auto p = j_descr.parent.lock()) {
+                    result = p->getDescription();
+                }
+                result += j_descr.static_descr;
+                if (auto pos = result.find("$VD"); pos != std::string::npos) {
+                    result.replace(pos, 3, j_descr.var_descr);
+                }
+                return result;
+            }
+        }
+    } else if (og.isIndirect()) {
+        return "object " + og.unparse(' ');
+    }
+    return {};
+}
+
+void
+QPDFObject::parseDeferred()
+{
+    auto deferred = std::get<QPDF_Deferred>(std::move(value));
+    // If the contents can't be parsed, leave an empty array or dictionary.
+    if (deferred.type_code == ::ot_array) {
+        value = std::move(QPDF_Array::create(std::vector<QPDFObjectHandle>())->value);
+    } else {
+        value = std::move(QPDF_Dictionary::create(QPDF_Dictionary::Items())->value);
+    }
+    auto parsed = QPDF::Resolver::parsed(deferred);
+    if (!parsed) {
+        // The QPDF the contents were to be read from has been destroyed.
+        value = QPDF_Destroyed();
+    } else if (parsed->getTypeCode() == deferred.type_code) {
+        value = std::move(parsed->value);
+    }
+}
+
+void
+QPDFObject::disconnect()
+{
+    if (auto array = std::get_if<QPDF_Array>(&value)) {
+        array->disconnect();
+    } else if (auto dict = std::get_if<QPDF_Dictionary>(&value)) {
+        dict->disconnect();
+    } else if (auto stream = std::get_if<QPDF_Stream>(&value)) {
+        stream->disconnect();
+    } else if (auto ref = reference()) {
+        // The object that replaced this one shares its value.
+        ref->disconnect();
+    } else if (isDeferred()) {
+        // The contents can't be read without the QPDF. This also frees any object stream data kept
+        // for them.
+        value = QPDF_Destroyed();
+    }
+    qpdf = nullptr;
+    og = QPDFObjGen();
+}
 
 void
 QPDFObject::destroy()
 {
-    value = QPDF_Destroyed::getInstance();
+    value = QPDF_Destroyed();
+    object_description = nullptr;
+    qpdf = nullptr;
+    og = QPDFObjGen();
+    parsed_offset = -1;
 }
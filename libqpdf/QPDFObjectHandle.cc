@@ -1148,7 +1148,7 @@ void
 QPDFObjectHandle::setArrayItem(int n, QPDFObjectHandle const& item)
 {
     if (auto array = asArray()) {
-        if (!array->setAt(n, item)) {
+        if (!array->setAt(n, item, obj->getQPDF())) {
             objectWarning("ignoring attempt to set out of bounds array item");
             QTC::TC("qpdf", "QPDFObjectHandle set array bounds");
         }
@@ -1161,7 +1161,7 @@ void
 QPDFObjectHandle::setArrayFromVector(std::vector<QPDFObjectHandle> const& items)
 {
     if (auto array = asArray()) {
-        array->setFromVector(items);
+        array->setFromVector(items, obj->getQPDF());
     } else {
         typeWarning("array", "ignoring attempt to replace items");
         QTC::TC("qpdf", "QPDFObjectHandle array ignoring replace items");
@@ -1172,7 +1172,7 @@ void
 QPDFObjectHandle::insertItem(int at, QPDFObjectHandle const& item)
 {
     if (auto array = asArray()) {
-        if (!array->insert(at, item)) {
+        if (!array->insert(at, item, obj->getQPDF())) {
             objectWarning("ignoring attempt to insert out of bounds array item");
             QTC::TC("qpdf", "QPDFObjectHandle insert array bounds");
         }
@@ -1193,7 +1193,7 @@ void
 QPDFObjectHandle::appendItem(QPDFObjectHandle const& item)
 {
     if (auto array = asArray()) {
-        array->push_back(item);
+        array->push_back(item, obj->getQPDF());
     } else {
         typeWarning("array", "ignoring attempt to append item");
         QTC::TC("qpdf", "QPDFObjectHandle array ignoring append item");
@@ -1265,7 +1265,13 @@ QPDFObjectHandle::getKey(std::string const& key) const
 #endif
 {
     if (auto dict = asDictionary()) {
-        return dict->getKey(key);
+        // PDF spec says fetching a non-existent key from a dictionary returns the null object.
+        if (auto value = dict->find(key)) {
+            // May be a null object
+            return *value;
+        }
+        static auto constexpr msg = " -> dictionary key $VD"sv;
+        return QPDF_Null::create(obj, msg, key);
     } else {
         typeWarning("dictionary", "returning null for attempted key retrieval");
         QTC::TC("qpdf", "QPDFObjectHandle dictionary null for getKey");
@@ -1559,7 +1565,7 @@ QPDFObjectHandle::removeKeyAndGetOld(std::string const& key)
     auto result = QPDFObjectHandle::newNull();
     auto dict = asDictionary();
     if (dict) {
-        result = dict->getKey(key);
+        result = getKey(key);
     }
     removeKey(key);
     return result;
@@ -2414,7 +2420,7 @@ void
 QPDFObjectHandle::setObjectDescription(QPDF* owning_qpdf, std::string const& object_description)
 {
     if (obj) {
-        auto descr = std::make_shared<QPDFValue::Description>(object_description);
+        auto descr = std::make_shared<QPDFObject::Description>(object_description);
         obj->setDescription(owning_qpdf, descr);
     }
 }
@@ -2472,9 +2478,8 @@ QPDFObjectHandle::makeDirect(QPDFObjGen::set& visited, bool stop_at_streams)
         this->obj = QPDF_Array::create(items);
     } else if (isDictionary()) {
         std::map<std::string, QPDFObjectHandle> items;
-        auto dict = asDictionary();
         for (auto const& key: getKeys()) {
-            items[key] = dict->getKey(key);
+            items[key] = getKey(key);
             items[key].makeDirect(visited, stop_at_streams);
         }
         this->obj = QPDF_Dictionary::create(items);
@@ -6,6 +6,7 @@
 #include <qpdf/QPDFObject_private.hh>
 #include <qpdf/QPDF_Array.hh>
 #include <qpdf/QPDF_Bool.hh>
+#include <qpdf/QPDF_Deferred.hh>
 #include <qpdf/QPDF_Dictionary.hh>
 #include <qpdf/QPDF_InlineImage.hh>
 #include <qpdf/QPDF_Integer.hh>
@@ -19,10 +20,30 @@
 #include <qpdf/QTC.hh>
 #include <qpdf/QUtil.hh>
 
+#include <charconv>
 #include <memory>
+#include <stdexcept>
 
 using ObjectPtr = std::shared_ptr<QPDFObject>;
 
+// Convert the value of an integer token in the same way as QUtil::string_to_ll. The token's value
+// may refer directly to the input and is not null-terminated.
+static long long
+to_ll(std::string_view value)
+{
+    long long result = 0;
+    auto first = value.data();
+    auto last = first + value.size();
+    if ((first != last) && (*first == '+')) {
+        ++first;
+    }
+    if (std::from_chars(first, last, result).ec == std::errc::result_out_of_range) {
+        throw std::range_error(
+            "overflow/underflow converting " + std::string(value) + " to 64-bit integer");
+    }
+    return result;
+}
+
 QPDFObjectHandle
 QPDFParser::parse(bool& empty, bool content_stream)
 {
@@ -35,7 +56,7 @@ QPDFParser::parse(bool& empty, bool content_stream)
     empty = false;
     start = input.tell();
 
-    if (!tokenizer.nextToken(input, object_description)) {
+    if (!tokenizer.nextToken(input, object_description, token)) {
         warn(tokenizer.getErrorMessage());
     }
 
@@ -79,23 +100,23 @@ QPDFParser::parse(bool& empty, bool content_stream)
         return parseRemainder(content_stream);
 
     case QPDFTokenizer::tt_bool:
-        return withDescription<QPDF_Bool>(tokenizer.getValue() == "true");
+        return withDescription<QPDF_Bool>(token.value == "true");
 
     case QPDFTokenizer::tt_null:
         return {QPDF_Null::create()};
 
     case QPDFTokenizer::tt_integer:
-        return withDescription<QPDF_Integer>(QUtil::string_to_ll(tokenizer.getValue().c_str()));
+        return withDescription<QPDF_Integer>(to_ll(token.value));
 
     case QPDFTokenizer::tt_real:
-        return withDescription<QPDF_Real>(tokenizer.getValue());
+        return withDescription<QPDF_Real>(token.value);
 
     case QPDFTokenizer::tt_name:
-        return withDescription<QPDF_Name>(tokenizer.getValue());
+        return withDescription<QPDF_Name>(token.value);
 
     case QPDFTokenizer::tt_word:
         {
-            auto const& value = tokenizer.getValue();
+            auto const& value = token.value;
             if (content_stream) {
                 return withDescription<QPDF_Operator>(value);
             } else if (value == "endobj") {
@@ -107,17 +128,17 @@ QPDFParser::parse(bool& empty, bool content_stream)
             } else {
                 QTC::TC("qpdf", "QPDFParser treat word as string");
                 warn("unknown token while reading object; treating as string");
-                return withDescription<QPDF_String>(value);
+                return withDescription<QPDF_String>(std::string(value));
             }
         }
 
     case QPDFTokenizer::tt_string:
         if (decrypter) {
-            std::string s{tokenizer.getValue()};
+            std::string s{token.value};
             decrypter->decryptString(s);
             return withDescription<QPDF_String>(s);
         } else {
-            return withDescription<QPDF_String>(tokenizer.getValue());
+            return withDescription<QPDF_String>(std::string(token.value));
         }
 
     default:
@@ -138,7 +159,7 @@ QPDFParser::parseRemainder(bool content_stream)
     bool b_contents = false;
 
     while (true) {
-        if (!tokenizer.nextToken(input, object_description)) {
+        if (!tokenizer.nextToken(input, object_description, token)) {
             warn(tokenizer.getErrorMessage());
         }
         ++good_count; // optimistically
@@ -152,12 +173,12 @@ QPDFParser::parseRemainder(bool content_stream)
                     addInt(int_count);
                 }
                 last_offset_buffer[int_count % 2] = input.getLastOffset();
-                int_buffer[int_count % 2] = QUtil::string_to_ll(tokenizer.getValue().c_str());
+                int_buffer[int_count % 2] = to_ll(token.value);
                 continue;
 
             } else if (
                 int_count >= 2 && tokenizer.getType() == QPDFTokenizer::tt_word &&
-                tokenizer.getValue() == "R") {
+                token.value == "R") {
                 if (context == nullptr) {
                     QTC::TC("qpdf", "QPDFParser indirect without context");
                     throw std::logic_error("QPDFParser::parse called without context on an object "
@@ -247,18 +268,21 @@ QPDFParser::parseRemainder(bool content_stream)
                     warn(
                         frame->offset,
                         "dictionary ended prematurely; using null as value for last key");
-                    dict[frame->key] = QPDF_Null::create();
+                    dict.insert_or_assign(frame->key, QPDF_Null::create());
                 }
 
                 if (!frame->olist.empty()) {
                     fixMissingKeys();
                 }
 
-                if (!frame->contents_string.empty() && dict.count("/Type") &&
-                    dict["/Type"].isNameAndEquals("/Sig") && dict.count("/ByteRange") &&
-                    dict.count("/Contents") && dict["/Contents"].isString()) {
-                    dict["/Contents"] = QPDFObjectHandle::newString(frame->contents_string);
-                    dict["/Contents"].setParsedOffset(frame->contents_offset);
+                if (!frame->contents_string.empty()) {
+                    auto type = dict.find("/Type");
+                    auto contents = dict.find("/Contents");
+                    if (type && type->isNameAndEquals("/Sig") && dict.find("/ByteRange") &&
+                        contents && contents->isString()) {
+                        *contents = QPDFObjectHandle::newString(frame->contents_string);
+                        contents->setParsedOffset(frame->contents_offset);
+                    }
                 }
                 auto object = QPDF_Dictionary::create(std::move(dict));
                 setDescription(object, frame->offset - 2);
@@ -290,16 +314,19 @@ QPDFParser::parseRemainder(bool content_stream)
                 return {QPDF_Null::create()};
             } else {
                 b_contents = false;
-                stack.emplace_back(
-                    input,
-                    (tokenizer.getType() == QPDFTokenizer::tt_array_open) ? st_array
-                                                                          : st_dictionary_key);
+                bool is_array = tokenizer.getType() == QPDFTokenizer::tt_array_open;
+                // Only defer the direct children of the object being parsed so that the data is
+                // scanned at most once before it is parsed.
+                if (deferred_input && stack.size() == 1 && defer(is_array)) {
+                    continue;
+                }
+                stack.emplace_back(input, is_array ? st_array : st_dictionary_key);
                 frame = &stack.back();
                 continue;
             }
 
         case QPDFTokenizer::tt_bool:
-            addScalar<QPDF_Bool>(tokenizer.getValue() == "true");
+            addScalar<QPDF_Bool>(token.value == "true");
             continue;
 
         case QPDFTokenizer::tt_null:
@@ -310,44 +337,44 @@ QPDFParser::parseRemainder(bool content_stream)
             if (!content_stream) {
                 // Buffer token in case it is part of an indirect reference.
                 last_offset_buffer[1] = input.getLastOffset();
-                int_buffer[1] = QUtil::string_to_ll(tokenizer.getValue().c_str());
+                int_buffer[1] = to_ll(token.value);
                 int_count = 1;
             } else {
-                addScalar<QPDF_Integer>(QUtil::string_to_ll(tokenizer.getValue().c_str()));
+                addScalar<QPDF_Integer>(to_ll(token.value));
             }
             continue;
 
         case QPDFTokenizer::tt_real:
-            addScalar<QPDF_Real>(tokenizer.getValue());
+            addScalar<QPDF_Real>(token.value);
             continue;
 
         case QPDFTokenizer::tt_name:
             if (frame->state == st_dictionary_key) {
-                frame->key = tokenizer.getValue();
+                frame->key = NameAtom(token.value);
                 frame->state = st_dictionary_value;
                 b_contents = decrypter && frame->key == "/Contents";
                 continue;
             } else {
-                addScalar<QPDF_Name>(tokenizer.getValue());
+                addScalar<QPDF_Name>(token.value);
             }
             continue;
 
         case QPDFTokenizer::tt_word:
             if (content_stream) {
-                addScalar<QPDF_Operator>(tokenizer.getValue());
+                addScalar<QPDF_Operator>(token.value);
             } else {
                 QTC::TC("qpdf", "QPDFParser treat word as string in parseRemainder");
                 warn("unknown token while reading object; treating as string");
                 if (tooManyBadTokens()) {
                     return {QPDF_Null::create()};
                 }
-                addScalar<QPDF_String>(tokenizer.getValue());
+                addScalar<QPDF_String>(std::string(token.value));
             }
             continue;
 
         case QPDFTokenizer::tt_string:
             {
-                auto const& val = tokenizer.getValue();
+                auto const& val = token.value;
                 if (decrypter) {
                     if (b_contents) {
                         frame->contents_string = val;
@@ -358,7 +385,7 @@ QPDFParser::parseRemainder(bool content_stream)
                     decrypter->decryptString(s);
                     addScalar<QPDF_String>(s);
                 } else {
-                    addScalar<QPDF_String>(val);
+                    addScalar<QPDF_String>(std::string(val));
                 }
             }
             continue;
@@ -373,6 +400,134 @@ QPDFParser::parseRemainder(bool content_stream)
     }
 }
 
+// Return true if the data after the opening delimiter of an array or dictionary appears to contain
+// its closing delimiter. This only looks at delimiters and skips strings and comments, so it is
+// much faster than tokenizing the data, but it may be wrong for data that is not valid PDF syntax.
+static bool
+appears_to_close(char const* data, size_t size)
+{
+    int depth = 1;
+    for (size_t i = 0; i < size; ++i) {
+        switch (data[i]) {
+        case '[':
+            ++depth;
+            break;
+        case ']':
+            --depth;
+            break;
+        case '<':
+            if (i + 1 < size && data[i + 1] == '<') {
+                ++depth;
+                ++i;
+            } else {
+                // Hexadecimal string
+                while (i < size && data[i] != '>') {
+                    ++i;
+                }
+            }
+            break;
+        case '>':
+            --depth;
+            ++i;
+            break;
+        case '(':
+            {
+                int parens = 1;
+                while (++i < size && parens > 0) {
+                    if (data[i] == '\\') {
+                        ++i;
+                    } else if (data[i] == '(') {
+                        ++parens;
+                    } else if (data[i] == ')') {
+                        --parens;
+                    }
+                }
+                --i;
+            }
+            break;
+        case '%':
+            while (i < size && data[i] != '\n' && data[i] != '\r') {
+                ++i;
+            }
+            break;
+        default:
+            break;
+        }
+        if (depth == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Skip over the nested array or dictionary whose opening delimiter has just been read and add a
+// deferred object for it, so that its contents are only parsed when they are accessed. Only large
+// arrays and dictionaries that consist of valid tokens are deferred so that parsing them later
+// gives the same result as parsing them now. Otherwise, return false with the input positioned
+// after the opening delimiter.
+bool
+QPDFParser::defer(bool is_array)
+{
+    static constexpr qpdf_offset_t min_deferred_size = 256;
+
+    auto offset = input.getLastOffset();
+    auto after_open = input.tell();
+    // Most arrays and dictionaries are small. Check for that quickly to avoid tokenizing them
+    // twice.
+    char data[min_deferred_size];
+    auto size = input.read(data, sizeof(data));
+    input.seek(after_open, SEEK_SET);
+    if (appears_to_close(data, size)) {
+        return false;
+    }
+    // The closing delimiters that are expected, innermost last.
+    std::string closers(1, is_array ? ']' : '>');
+    // The number of integers just read, which may start an indirect reference.
+    int ints = 0;
+    while (!closers.empty() && stack.size() + closers.size() < 500 &&
+           tokenizer.nextToken(input, object_description, token)) {
+        auto type = tokenizer.getType();
+        if (type == QPDFTokenizer::tt_integer) {
+            ++ints;
+            continue;
+        }
+        if (type == QPDFTokenizer::tt_word && ints >= 2 && token.value == "R") {
+            ints = 0;
+            continue;
+        }
+        ints = 0;
+        if (type == QPDFTokenizer::tt_array_open) {
+            closers += ']';
+        } else if (type == QPDFTokenizer::tt_dict_open) {
+            closers += '>';
+        } else if (type == QPDFTokenizer::tt_array_close) {
+            if (closers.back() != ']') {
+                break;
+            }
+            closers.pop_back();
+        } else if (type == QPDFTokenizer::tt_dict_close) {
+            if (closers.back() != '>') {
+                break;
+            }
+            closers.pop_back();
+        } else if (!(type == QPDFTokenizer::tt_bool || type == QPDFTokenizer::tt_null ||
+                     type == QPDFTokenizer::tt_real || type == QPDFTokenizer::tt_name ||
+                     type == QPDFTokenizer::tt_string)) {
+            break;
+        }
+    }
+    if (!closers.empty() || input.tell() - offset < min_deferred_size) {
+        input.seek(after_open, SEEK_SET);
+        return false;
+    }
+    QTC::TC("qpdf", "QPDFParser defer container", is_array ? 0 : 1);
+    auto object =
+        QPDF_Deferred::create(deferred_input, offset, is_array ? ::ot_array : ::ot_dictionary);
+    setDescription(object, offset);
+    add(std::move(object));
+    return true;
+}
+
 void
 QPDFParser::add(std::shared_ptr<QPDFObject>&& obj)
 {
@@ -381,7 +536,7 @@ QPDFParser::add(std::shared_ptr<QPDFObject>&& obj)
         // processing once the tt_dict_close token has been found.
         frame->olist.emplace_back(std::move(obj));
     } else {
-        if (auto res = frame->dict.insert_or_assign(frame->key, std::move(obj)); !res.second) {
+        if (!frame->dict.insert_or_assign(frame->key, std::move(obj))) {
             warnDuplicateKey();
         }
         frame->state = st_dictionary_key;
@@ -398,7 +553,7 @@ QPDFParser::addNull()
         // processing once the tt_dict_close token has been found.
         frame->olist.emplace_back(null_obj);
     } else {
-        if (auto res = frame->dict.insert_or_assign(frame->key, null_obj); !res.second) {
+        if (!frame->dict.insert_or_assign(frame->key, null_obj)) {
             warnDuplicateKey();
         }
         frame->state = st_dictionary_key;
@@ -453,13 +608,13 @@ QPDFParser::fixMissingKeys()
     for (auto const& item: frame->olist) {
         while (true) {
             const std::string key = "/QPDFFake" + std::to_string(next_fake_key++);
-            const bool found_fake = frame->dict.count(key) == 0 && names.count(key) == 0;
+            const bool found_fake = !frame->dict.find(key) && names.count(key) == 0;
             QTC::TC("qpdf", "QPDFParser found fake", (found_fake ? 0 : 1));
             if (found_fake) {
                 warn(
                     frame->offset,
                     "expected dictionary key but found non-name object; inserting key " + key);
-                frame->dict[key] = item;
+                frame->dict.insert_or_assign(NameAtom(key), item);
                 break;
             }
         }
@@ -501,7 +656,8 @@ QPDFParser::warnDuplicateKey()
     QTC::TC("qpdf", "QPDFParser duplicate dict key");
     warn(
         frame->offset,
-        "dictionary has duplicated key " + frame->key + "; last occurrence overrides earlier ones");
+        "dictionary has duplicated key " + frame->key.str() +
+            "; last occurrence overrides earlier ones");
 }
 
 void
@@ -1,4 +1,4 @@
-#include <qpdf/QPDFTokenizer.hh>
+#include <qpdf/QPDFTokenizer_private.hh>
 
 // DO NOT USE ctype -- it is locale dependent for some things, and it's not worth the risk of
 // including it in case it may accidentally be used.
@@ -9,6 +9,7 @@
 #include <qpdf/QTC.hh>
 #include <qpdf/QUtil.hh>
 
+#include <array>
 #include <cstdlib>
 #include <cstring>
 #include <stdexcept>
@@ -22,6 +23,34 @@ is_delimiter(char ch)
         ch == '\v' || ch == '\f' || ch == 0);
 }
 
+namespace
+{
+    // Character classes used by QPDFTokenizer::scanContiguous. cc_space and cc_delimiter match
+    // QPDFTokenizer::isSpace and is_delimiter. cc_string marks the characters that end a run of
+    // ordinary characters in a literal string.
+    enum char_class_e : unsigned char { cc_space = 1, cc_delimiter = 2, cc_string = 4 };
+
+    constexpr std::array<unsigned char, 256> char_classes = []() {
+        std::array<unsigned char, 256> classes{};
+        for (char ch: {'\0', ' ', '\t', '\n', '\v', '\f', '\r'}) {
+            classes[static_cast<unsigned char>(ch)] |= cc_space | cc_delimiter;
+        }
+        for (char ch: {'/', '(', ')', '{', '}', '<', '>', '[', ']', '%'}) {
+            classes[static_cast<unsigned char>(ch)] |= cc_delimiter;
+        }
+        for (char ch: {'\\', '(', ')', '\r'}) {
+            classes[static_cast<unsigned char>(ch)] |= cc_string;
+        }
+        return classes;
+    }();
+
+    inline bool
+    has_class(char ch, char_class_e cc)
+    {
+        return char_classes[static_cast<unsigned char>(ch)] & cc;
+    }
+} // namespace
+
 namespace
 {
     class QPDFWordTokenFinder: public InputSource::Finder
@@ -886,16 +915,203 @@ QPDFTokenizer::betweenTokens()
     return this->before_token;
 }
 
+void
+QPDFTokenizer::scanContiguous(
+    char const* data, size_t size, qpdf_offset_t& pos, qpdf_offset_t& offset, Views& views)
+{
+    // This is a faster equivalent of running the state machine from st_before_token on input that
+    // is all in memory. It skips white space and comments and reads the most common kinds of tokens
+    // a run of characters at a time. Anything it doesn't handle is left to the state machine: it
+    // returns with pos at the next character to present and the tokenizer in the state the state
+    // machine would have reached by then. If it returns in st_token_ready, pos is where the input
+    // should be positioned after the token, and the token's values are in views. Except for
+    // strings, these refer directly to data, so val and raw_val are not set. On return, offset is
+    // the start of the token.
+    if (QIntC::to_size(pos) >= size) {
+        return;
+    }
+    char const* p = data + pos;
+    char const* end = data + size;
+
+    if (this->include_ignorable) {
+        if (has_class(*p, cc_space) || (*p == '%')) {
+            return;
+        }
+    } else {
+        while (true) {
+            while ((p < end) && has_class(*p, cc_space)) {
+                ++p;
+            }
+            if ((p == end) || (*p != '%')) {
+                break;
+            }
+            while ((p < end) && (*p != '\r') && (*p != '\n')) {
+                ++p;
+            }
+            if (p == end) {
+                this->state = st_in_comment;
+                break;
+            }
+        }
+        pos = offset = p - data;
+        if (p == end) {
+            return;
+        }
+    }
+
+    char const* start = p;
+    // Finish a token that ends at a delimiter that must be unread.
+    auto ready_before = [this, data, start, &p, &pos, &views](token_type_e token_type) {
+        this->type = token_type;
+        this->in_token = false;
+        this->char_to_unread = *p;
+        this->state = st_token_ready;
+        pos = p - data;
+        views.value = views.raw_value = {start, QIntC::to_size(p - start)};
+    };
+    // Finish a token that ends with the character at p.
+    auto ready_after = [this, data, start, &p, &pos, &views](token_type_e token_type) {
+        this->type = token_type;
+        this->state = st_token_ready;
+        pos = p + 1 - data;
+        views.value = views.raw_value = {start, QIntC::to_size(p + 1 - start)};
+    };
+    // Leave the rest of the token to the state machine.
+    auto resume = [this, data, &p, &pos](state_e resume_state) {
+        this->state = resume_state;
+        pos = p - data;
+    };
+
+    switch (*p) {
+    case '[':
+    case ']':
+    case '{':
+    case '}':
+        this->before_token = false;
+        this->in_token = true;
+        ready_after(
+            *p == '[' ? tt_array_open
+                : *p == ']' ? tt_array_close
+                : *p == '{' ? tt_brace_open
+                            : tt_brace_close);
+        return;
+
+    case '<':
+    case '>':
+        if ((p + 1 == end) || (p[1] != *p)) {
+            return;
+        }
+        this->before_token = false;
+        this->in_token = true;
+        ++p;
+        ready_after(*p == '<' ? tt_dict_open : tt_dict_close);
+        return;
+
+    case '/':
+        this->before_token = false;
+        this->in_token = true;
+        ++p;
+        while ((p < end) && !has_class(*p, cc_delimiter) && (*p != '#')) {
+            ++p;
+        }
+        if ((p < end) && (*p != '#')) {
+            ready_before(tt_name);
+        } else {
+            this->raw_val.assign(start, QIntC::to_size(p - start));
+            this->val = this->raw_val;
+            resume(st_name);
+        }
+        return;
+
+    case '(':
+        this->before_token = false;
+        this->in_token = true;
+        this->string_depth = 1;
+        ++p;
+        while (true) {
+            char const* run = p;
+            while ((p < end) && !has_class(*p, cc_string)) {
+                ++p;
+            }
+            this->val.append(run, QIntC::to_size(p - run));
+            if ((p == end) || (*p == '\\') || (*p == '\r')) {
+                this->raw_val.assign(start, QIntC::to_size(p - start));
+                resume(st_in_string);
+                return;
+            }
+            if (*p == '(') {
+                ++this->string_depth;
+            } else if (--this->string_depth == 0) {
+                this->raw_val.assign(start, QIntC::to_size(p + 1 - start));
+                ready_after(tt_string);
+                views.value = this->val;
+                views.raw_value = this->raw_val;
+                return;
+            }
+            this->val += *p;
+            ++p;
+        }
+
+    case ')':
+        return;
+
+    default:
+        break;
+    }
+
+    // Anything else is a number or a word running up to the next delimiter. Track the state the
+    // state machine would be in after each character.
+    this->before_token = false;
+    this->in_token = true;
+    state_e s = QUtil::is_digit(*p) ? st_number
+        : (*p == '+' || *p == '-')  ? st_sign
+        : *p == '.'                 ? st_decimal
+                                    : st_literal;
+    for (++p; (p < end) && !has_class(*p, cc_delimiter); ++p) {
+        char ch = *p;
+        switch (s) {
+        case st_number:
+            s = QUtil::is_digit(ch) ? st_number : ch == '.' ? st_real : st_literal;
+            break;
+        case st_real:
+            s = QUtil::is_digit(ch) ? st_real : st_literal;
+            break;
+        case st_sign:
+            s = QUtil::is_digit(ch) ? st_number : ch == '.' ? st_decimal : st_literal;
+            break;
+        case st_decimal:
+            s = QUtil::is_digit(ch) ? st_real : st_literal;
+            break;
+        default:
+            break;
+        }
+    }
+    std::string_view word{start, QIntC::to_size(p - start)};
+    if (p == end) {
+        this->raw_val = word;
+        resume(s);
+    } else if (s == st_number) {
+        ready_before(tt_integer);
+    } else if (s == st_real) {
+        ready_before(tt_real);
+    } else {
+        ready_before(
+            (word == "true") || (word == "false") ? tt_bool
+                : word == "null"                  ? tt_null
+                                                  : tt_word);
+    }
+}
+
 QPDFTokenizer::Token
 QPDFTokenizer::readToken(
     InputSource& input, std::string const& context, bool allow_bad, size_t max_len)
 {
-    nextToken(input, context, max_len);
+    Views views;
+    nextToken(input, context, views, max_len);
 
-    Token token;
-    bool unread_char;
-    char char_to_unread;
-    getToken(token, unread_char, char_to_unread);
+    Token token(
+        this->type, std::string(views.value), std::string(views.raw_value), this->error_message);
+    reset();
 
     if (token.getType() == tt_bad) {
         if (allow_bad) {
@@ -920,12 +1136,30 @@ QPDFTokenizer::readToken(
 }
 
 bool
-QPDFTokenizer::nextToken(InputSource& input, std::string const& context, size_t max_len)
+QPDFTokenizer::nextToken(
+    InputSource& input, std::string const& context, Views& views, size_t max_len)
 {
     if (this->state != st_inline_image) {
         reset();
     }
-    qpdf_offset_t offset = input.fastTell();
+    qpdf_offset_t offset = 0;
+    char const* data = nullptr;
+    size_t size = 0;
+    if ((max_len == 0) && (this->state == st_before_token) &&
+        input.getContiguousData(data, size)) {
+        offset = input.tell();
+        qpdf_offset_t pos = offset;
+        scanContiguous(data, size, pos, offset, views);
+        input.seek(pos, SEEK_SET);
+        if (this->state == st_token_ready) {
+            input.setLastOffset(offset);
+            return this->error_message.empty();
+        }
+        // Let the state machine finish the token.
+        input.fastTell();
+    } else {
+        offset = input.fastTell();
+    }
 
     while (this->state != st_token_ready) {
         char ch;
@@ -962,6 +1196,8 @@ QPDFTokenizer::nextToken(InputSource& input, std::string const& context, size_t
     if (this->type != tt_eof) {
         input.setLastOffset(offset);
     }
+    views.value = (this->type == tt_name || this->type == tt_string) ? this->val : this->raw_val;
+    views.raw_value = this->raw_val;
 
     return this->error_message.empty();
 }
@@ -6,6 +6,7 @@
 
 #include <qpdf/MD5.hh>
 #include <qpdf/Pl_AES_PDF.hh>
+#include <qpdf/Pl_Concatenate.hh>
 #include <qpdf/Pl_Count.hh>
 #include <qpdf/Pl_Discard.hh>
 #include <qpdf/Pl_Flate.hh>
@@ -15,7 +16,9 @@
 #include <qpdf/Pl_StdioFile.hh>
 #include <qpdf/QIntC.hh>
 #include <qpdf/QPDFObjectHandle.hh>
+#include <qpdf/QPDFObject_private.hh>
 #include <qpdf/QPDF_Name.hh>
+#include <qpdf/QPDF_Stream.hh>
 #include <qpdf/QPDF_String.hh>
 #include <qpdf/QPDF_private.hh>
 #include <qpdf/QTC.hh>
@@ -23,6 +26,7 @@
 #include <qpdf/RC4.hh>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <stdexcept>
 
@@ -62,6 +66,82 @@ QPDFWriter::Members::~Members()
     delete output_buffer;
 }
 
+LinearizationCache::~LinearizationCache()
+{
+    if (file) {
+        fclose(file);
+    }
+}
+
+bool
+LinearizationCache::openFile()
+{
+    if (use_file && !file) {
+        try {
+            file = QUtil::temp_file();
+        } catch (std::runtime_error&) {
+            use_file = false;
+        }
+    }
+    return use_file;
+}
+
+bool
+LinearizationCache::store(std::shared_ptr<Buffer> const& data, Item& item)
+{
+    item.size = data->getSize();
+    if (item.size <= memory_limit - memory_used) {
+        memory_used += item.size;
+        item.data = data;
+        return true;
+    }
+    if (!file) {
+        return false;
+    }
+    // If a write fails, the next one overwrites whatever part of this one was written.
+    if (QUtil::seek(file, file_size, SEEK_SET) != 0 ||
+        fwrite(data->getBuffer(), 1, item.size, file) != item.size) {
+        return false;
+    }
+    item.data = nullptr;
+    item.offset = file_size;
+    file_size += QIntC::to_offset(item.size);
+    return true;
+}
+
+std::shared_ptr<Buffer>
+LinearizationCache::load(Item const& item)
+{
+    if (item.data) {
+        return item.data;
+    }
+    auto data = std::make_shared<Buffer>(item.size);
+    if (QUtil::seek(file, item.offset, SEEK_SET) != 0 ||
+        fread(data->getBuffer(), 1, item.size, file) != item.size) {
+        throw std::runtime_error("unable to read data back from linearization cache file");
+    }
+    return data;
+}
+
+void
+LinearizationCache::release(Item const& item)
+{
+    if (item.data) {
+        memory_used -= item.size;
+    }
+}
+
+void
+LinearizationCache::clear()
+{
+    memory_used = 0;
+    file_size = 0;
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
 QPDFWriter::QPDFWriter(QPDF& pdf) :
     m(new Members(pdf))
 {
@@ -188,6 +268,12 @@ QPDFWriter::setRecompressFlate(bool val)
     m->recompress_flate = val;
 }
 
+void
+QPDFWriter::setCompressionThreads(int n)
+{
+    m->compression_threads = n;
+}
+
 void
 QPDFWriter::setContentNormalization(bool val)
 {
@@ -213,6 +299,18 @@ QPDFWriter::setNewlineBeforeEndstream(bool val)
     m->newline_before_endstream = val;
 }
 
+void
+QPDFWriter::setIndirectStreamLengths(bool val)
+{
+    m->indirect_stream_lengths = val;
+}
+
+void
+QPDFWriter::setReleaseWrittenObjects(bool val)
+{
+    m->release_written_objects = val;
+}
+
 void
 QPDFWriter::setMinimumPDFVersion(std::string const& version, int extension_level)
 {
@@ -324,6 +422,25 @@ QPDFWriter::setLinearizationPass1Filename(std::string const& filename)
     m->lin_pass1_filename = filename;
 }
 
+void
+QPDFWriter::setLinearizationCacheSize(size_t val)
+{
+    m->lin_cache.memory_limit = val;
+}
+
+void
+QPDFWriter::setLinearizationCacheFile(bool val)
+{
+    m->lin_cache.use_file = val;
+}
+
+void
+QPDFWriter::registerLinearizationTimer(
+    std::function<void(std::string const& phase, double seconds)> timer)
+{
+    m->lin_timer = timer;
+}
+
 void
 QPDFWriter::setPCLm(bool val)
 {
@@ -1083,20 +1200,23 @@ QPDFWriter::enqueueObject(QPDFObjectHandle object)
                                    "QPDF::copyForeignObject to add objects from another file.");
         }
 
-        if (m->qdf_mode && object.isStreamOfType("/XRef")) {
-            // As a special case, do not output any extraneous XRef streams in QDF mode. Doing so
-            // will confuse fix-qdf, which expects to see only one XRef stream at the end of the
-            // file. This case can occur when creating a QDF from a file with object streams when
-            // preserving unreferenced objects since the old cross reference streams are not
-            // actually referenced by object number.
-            QTC::TC("qpdf", "QPDFWriter ignore XRef in qdf mode");
-            return;
-        }
-
         QPDFObjGen og = object.getObjGen();
         auto& obj = m->obj[og];
 
         if (obj.renumber == 0) {
+            // Whether the object is a stream only matters with indirect stream lengths (which QDF
+            // mode always uses). When objects are released after writing, QPDF::Writer::isStream
+            // avoids keeping objects in memory just to answer this.
+            bool is_stream = !m->direct_stream_lengths && QPDF::Writer::isStream(m->pdf, object);
+            if (is_stream && m->qdf_mode && object.isStreamOfType("/XRef")) {
+                // As a special case, do not output any extraneous XRef streams in QDF mode. Doing
+                // so will confuse fix-qdf, which expects to see only one XRef stream at the end of
+                // the file. This case can occur when creating a QDF from a file with object streams
+                // when preserving unreferenced objects since the old cross reference streams are
+                // not actually referenced by object number.
+                QTC::TC("qpdf", "QPDFWriter ignore XRef in qdf mode");
+                return;
+            }
             if (obj.object_stream > 0) {
                 // This is in an object stream.  Don't process it here.  Instead, enqueue the object
                 // stream.  Object streams always have generation 0.
@@ -1113,7 +1233,7 @@ QPDFWriter::enqueueObject(QPDFObjectHandle object)
                     if (!m->linearized) {
                         assignCompressedObjectNumbers(og);
                     }
-                } else if ((!m->direct_stream_lengths) && object.isStream()) {
+                } else if (is_stream) {
                     // reserve next object ID for length
                     ++m->next_objid;
                 }
@@ -1238,12 +1358,56 @@ QPDFWriter::willFilterStream(
     QPDFObjectHandle stream,
     bool& compress_stream, // out only
     bool& is_metadata,     // out only
-    std::shared_ptr<Buffer>* stream_data)
+    std::shared_ptr<Buffer>* stream_data,
+    bool defer_compression,
+    bool allow_unbuffered)
 {
     compress_stream = false;
     is_metadata = false;
 
     QPDFObjGen old_og = stream.getObjGen();
+
+    if (stream_data && !m->lin_streams.empty()) {
+        auto it = m->lin_streams.find(old_og);
+        if (it != m->lin_streams.end()) {
+            compress_stream = it->second.compress_stream;
+            is_metadata = it->second.is_metadata;
+            *stream_data = m->lin_cache.load(it->second.data);
+            bool filtered = it->second.filtered;
+            if (!m->fill_lin_cache) {
+                m->lin_cache.release(it->second.data);
+                m->lin_streams.erase(it);
+            }
+            return filtered;
+        }
+    }
+
+    if (stream_data && !m->prefiltered.empty()) {
+        auto it = m->prefiltered.find(old_og);
+        if (it != m->prefiltered.end()) {
+            // Wait for any compression task before moving the entry since the task writes to it.
+            if (it->second.compressed.valid()) {
+                it->second.compressed.wait();
+            }
+            auto entry = std::move(it->second);
+            m->prefiltered.erase(it);
+            if (entry.compressed.valid()) {
+                try {
+                    entry.compressed.get();
+                } catch (std::runtime_error& e) {
+                    throw std::runtime_error(
+                        "error while getting stream data for " + stream.unparse() + ": " +
+                        e.what());
+                }
+            }
+            compress_stream = entry.compress_stream;
+            is_metadata = entry.is_metadata;
+            *stream_data = entry.data;
+            cacheFilteredStream(old_og, entry.filtered, compress_stream, is_metadata, entry.data);
+            return entry.filtered;
+        }
+    }
+
     QPDFObjectHandle stream_dict = stream.getDict();
 
     if (stream_dict.isDictionaryOfType("/Metadata")) {
@@ -1282,17 +1446,66 @@ QPDFWriter::willFilterStream(
         QTC::TC("qpdf", "QPDFWriter compressing uncompressed stream");
     }
 
+    bool in_input = allow_unbuffered &&
+        QPDF::Writer::getRawStreamDataRange(
+            m->pdf, stream, m->unbuffered.offset, m->unbuffered.length);
+    if (in_input) {
+        if (filter &&
+            !stream.pipeStreamData(
+                nullptr,
+                ((normalize ? qpdf_ef_normalize : 0) | (compress_stream ? qpdf_ef_compress : 0)),
+                (uncompress ? qpdf_dl_all : m->stream_decode_level),
+                false)) {
+            // The stream's filters can't be decoded, so the loop below would end up writing the
+            // data unfiltered on its second attempt.
+            filter = false;
+            stream.setFilterOnWrite(false);
+        }
+        if (!filter) {
+            // The stream is written exactly as it appears in the input. Rather than buffering it,
+            // leave stream_data null so that the caller copies it straight from the input file.
+            QTC::TC("qpdf", "QPDFWriter copy raw stream data");
+            m->unbuffered.raw = true;
+            stream_data->reset();
+            compress_stream = false;
+            return false;
+        }
+    }
+    if (allow_unbuffered && filter && !m->direct_stream_lengths && !stream.isDataModified() &&
+        (in_input || stream.getObjectPtr()->as<QPDF_Stream>()->getStreamDataBuffer())) {
+        // With indirect lengths, the length need not be known before the data is written. If the
+        // data only needs to be encoded, which can't fail, it can be written as it is filtered.
+        auto filter_obj = stream_dict.getKey("/Filter");
+        if (filter_obj.isNull() || (filter_obj.isArray() && (filter_obj.getArrayNItems() == 0))) {
+            QTC::TC("qpdf", "QPDFWriter write stream data unbuffered");
+            m->unbuffered.raw = false;
+            m->unbuffered.encode_flags =
+                ((normalize ? qpdf_ef_normalize : 0) | (compress_stream ? qpdf_ef_compress : 0));
+            m->unbuffered.decode_level = (uncompress ? qpdf_dl_all : m->stream_decode_level);
+            stream_data->reset();
+            return true;
+        }
+    }
+
     bool filtered = false;
     for (int attempt = 1; attempt <= 2; ++attempt) {
         pushPipeline(new Pl_Buffer("stream data"));
         PipelinePopper pp_stream_data(this, stream_data);
         activatePipelineStack(pp_stream_data);
+        auto decode_level =
+            (filter ? (uncompress ? qpdf_dl_all : m->stream_decode_level) : qpdf_dl_none);
+        bool defer = defer_compression && filter && compress_stream;
+        if (defer) {
+            // The caller compresses the data. Without qpdf_ef_compress, pipeStreamData would not
+            // filter at all at decode level none, so ask for the equivalent generalized level.
+            decode_level = std::max(qpdf_dl_generalized, decode_level);
+        }
         try {
             filtered = stream.pipeStreamData(
                 m->pipeline,
                 (((filter && normalize) ? qpdf_ef_normalize : 0) |
-                 ((filter && compress_stream) ? qpdf_ef_compress : 0)),
-                (filter ? (uncompress ? qpdf_dl_all : m->stream_decode_level) : qpdf_dl_none),
+                 ((filter && compress_stream && !defer) ? qpdf_ef_compress : 0)),
+                decode_level,
                 false,
                 (attempt == 1));
         } catch (std::runtime_error& e) {
@@ -1310,9 +1523,86 @@ QPDFWriter::willFilterStream(
     if (!filtered) {
         compress_stream = false;
     }
+    if (stream_data) {
+        cacheFilteredStream(old_og, filtered, compress_stream, is_metadata, *stream_data);
+    }
     return filtered;
 }
 
+void
+QPDFWriter::cacheFilteredStream(
+    QPDFObjGen og,
+    bool filtered,
+    bool compress_stream,
+    bool is_metadata,
+    std::shared_ptr<Buffer> const& data)
+{
+    if (!(m->fill_lin_cache && data) || m->lin_streams.count(og)) {
+        return;
+    }
+    Members::CachedStream entry{filtered, compress_stream, is_metadata, {}};
+    if (m->lin_cache.store(data, entry.data)) {
+        m->lin_streams.emplace(og, std::move(entry));
+    }
+}
+
+void
+QPDFWriter::prefilterStreams(size_t next)
+{
+    // Retrieve the data for streams that are about to be written and hand their compression to the
+    // worker pool so it can proceed while earlier objects are written. The number of buffered
+    // streams is bounded so that memory use does not grow with the size of the file.
+    if (!m->worker_pool) {
+        return;
+    }
+    size_t const max_pending = 4 * m->worker_pool->size();
+    m->prefilter_next = std::max(m->prefilter_next, next);
+    while (m->prefiltered.size() < max_pending && m->prefilter_next < m->object_queue.size()) {
+        auto object = m->object_queue.at(m->prefilter_next++);
+        QPDFObjGen og = object.getObjGen();
+        if (object.isStream() && !m->lin_streams.count(og) &&
+            !((og.getGen() == 0) && m->object_stream_to_objects.count(og.getObj()))) {
+            prefilterStream(object);
+        }
+    }
+}
+
+void
+QPDFWriter::prefilterStream(QPDFObjectHandle stream)
+{
+    Members::Prefiltered result;
+    result.filtered = willFilterStream(
+        stream, result.compress_stream, result.is_metadata, &result.data, true, true);
+    if (!result.data) {
+        // The stream will be copied directly from the input when it is written.
+        return;
+    }
+    auto& entry = m->prefiltered[stream.getObjGen()] = std::move(result);
+    if (!(entry.filtered && entry.compress_stream)) {
+        return;
+    }
+    // Only the compression step runs on a worker thread. It uses nothing but its input buffer and
+    // the map entry, which stays in place until the result has been collected.
+    entry.compressed = m->worker_pool->submit([&entry, in = entry.data]() {
+        Pl_Buffer out("compressed stream data");
+        Pl_Flate("compress stream", &out, Pl_Flate::a_deflate)
+            .writeAll(in->getBuffer(), in->getSize());
+        entry.data = out.getBufferSharedPointer();
+    });
+}
+
+void
+QPDFWriter::clearPrefilteredStreams()
+{
+    for (auto& [og, entry]: m->prefiltered) {
+        if (entry.compressed.valid()) {
+            entry.compressed.wait();
+        }
+    }
+    m->prefiltered.clear();
+    m->prefilter_next = 0;
+}
+
 void
 QPDFWriter::unparseObject(
     QPDFObjectHandle object, int level, int flags, size_t stream_length, bool compress)
@@ -1534,12 +1824,15 @@ QPDFWriter::unparseObject(
         bool compress_stream = false;
         bool is_metadata = false;
         std::shared_ptr<Buffer> stream_data;
-        if (willFilterStream(object, compress_stream, is_metadata, &stream_data)) {
+        if (willFilterStream(
+                object, compress_stream, is_metadata, &stream_data, false, true)) {
             flags |= f_filtered;
         }
         QPDFObjectHandle stream_dict = object.getDict();
 
-        m->cur_stream_length = stream_data->getSize();
+        // Without stream_data, the length is only known in advance when copying raw data, but it
+        // isn't needed before the data is written when stream lengths are indirect.
+        m->cur_stream_length = stream_data ? stream_data->getSize() : m->unbuffered.length;
         if (is_metadata && m->encrypted && (!m->encrypt_metadata)) {
             // Don't encrypt stream data for the metadata stream
             m->cur_data_key.clear();
@@ -1551,7 +1844,24 @@ QPDFWriter::unparseObject(
         {
             PipelinePopper pp_enc(this);
             pushEncryptionFilter(pp_enc);
-            writeBuffer(stream_data);
+            if (stream_data) {
+                writeBuffer(stream_data);
+            } else if (m->unbuffered.raw) {
+                QPDF::Writer::pipeRawStreamData(
+                    m->pdf, m->unbuffered.offset, m->unbuffered.length, m->pipeline);
+            } else {
+                // pipeStreamData finishes its pipeline, but the encryption filter must only be
+                // finished once, when pp_enc goes out of scope.
+                Pl_Concatenate stream_pipeline("stream data", m->pipeline);
+                object.pipeStreamData(
+                    &stream_pipeline,
+                    m->unbuffered.encode_flags,
+                    m->unbuffered.decode_level,
+                    false,
+                    false);
+                m->cur_stream_length = QIntC::to_size(m->pipeline->getCount());
+                adjustAESStreamLength(m->cur_stream_length);
+            }
             last_char = m->pipeline->getLastChar();
         }
 
@@ -1626,84 +1936,122 @@ QPDFWriter::writeObjectStream(QPDFObjectHandle object)
     int old_id = old_og.getObj();
     int new_stream_id = m->obj[old_og].renumber;
 
-    std::vector<qpdf_offset_t> offsets;
-    qpdf_offset_t first = 0;
-
-    // Generate stream itself.  We have to do this in two passes so we can calculate offsets in the
-    // first pass.
     std::shared_ptr<Buffer> stream_buffer;
-    int first_obj = -1;
+    size_t n = 0;
+    qpdf_offset_t first = 0;
     bool compressed = false;
-    for (int pass = 1; pass <= 2; ++pass) {
-        // stream_buffer will be initialized only for pass 2
-        PipelinePopper pp_ostream(this, &stream_buffer);
-        if (pass == 1) {
-            pushDiscardFilter(pp_ostream);
-        } else {
-            // Adjust offsets to skip over comment before first object
-            first = offsets.at(0);
-            for (auto& iter: offsets) {
-                iter -= first;
-            }
+    auto cached = m->lin_object_streams.find(old_id);
+    if (cached != m->lin_object_streams.end()) {
+        // The contents were generated in the first pass of writing a linearized file.
+        stream_buffer = m->lin_cache.load(cached->second.data);
+        n = cached->second.n;
+        first = cached->second.first;
+        compressed = cached->second.compressed;
+        if (!m->fill_lin_cache) {
+            m->lin_cache.release(cached->second.data);
+            m->lin_object_streams.erase(cached);
+        }
+        int count = 0;
+        for (auto const& obj: m->object_stream_to_objects[old_id]) {
+            indicateProgress(false, false);
+            m->new_obj[m->obj[obj].renumber].xref = QPDFXRefEntry(new_stream_id, count++);
+        }
+    } else {
+        // Generate stream itself.  We have to do this in two passes so we can calculate offsets in
+        // the first pass.
+        std::vector<qpdf_offset_t> offsets;
+        int first_obj = -1;
+        bool warned = false;
+        for (int pass = 1; pass <= 2; ++pass) {
+            // stream_buffer will be initialized only for pass 2
+            PipelinePopper pp_ostream(this, &stream_buffer);
+            if (pass == 1) {
+                pushDiscardFilter(pp_ostream);
+            } else {
+                // Adjust offsets to skip over comment before first object
+                first = offsets.at(0);
+                for (auto& iter: offsets) {
+                    iter -= first;
+                }
 
-            // Take one pass at writing pairs of numbers so we can get their size information
-            {
-                PipelinePopper pp_discard(this);
-                pushDiscardFilter(pp_discard);
+                // Take one pass at writing pairs of numbers so we can get their size information
+                {
+                    PipelinePopper pp_discard(this);
+                    pushDiscardFilter(pp_discard);
+                    writeObjectStreamOffsets(offsets, first_obj);
+                    first += m->pipeline->getCount();
+                }
+
+                // Set up a stream to write the stream data into a buffer. It is compressed all at
+                // once after the last object has been written.
+                pushPipeline(new Pl_Buffer("object stream"));
+                compressed = m->compress_streams && !m->qdf_mode;
+                activatePipelineStack(pp_ostream);
                 writeObjectStreamOffsets(offsets, first_obj);
-                first += m->pipeline->getCount();
             }
 
-            // Set up a stream to write the stream data into a buffer.
-            Pipeline* next = pushPipeline(new Pl_Buffer("object stream"));
-            if (m->compress_streams && !m->qdf_mode) {
-                compressed = true;
-                next =
-                    pushPipeline(new Pl_Flate("compress object stream", next, Pl_Flate::a_deflate));
-            }
-            activatePipelineStack(pp_ostream);
-            writeObjectStreamOffsets(offsets, first_obj);
-        }
-
-        int count = -1;
-        for (auto const& obj: m->object_stream_to_objects[old_id]) {
-            ++count;
-            int new_obj = m->obj[obj].renumber;
-            if (first_obj == -1) {
-                first_obj = new_obj;
-            }
-            if (m->qdf_mode) {
-                writeString(
-                    "%% Object stream: object " + std::to_string(new_obj) + ", index " +
-                    std::to_string(count));
-                if (!m->suppress_original_object_ids) {
-                    writeString("; original object ID: " + std::to_string(obj.getObj()));
-                    // For compatibility, only write the generation if non-zero.  While object
-                    // streams only allow objects with generation 0, if we are generating object
-                    // streams, the old object could have a non-zero generation.
-                    if (obj.getGen() != 0) {
-                        QTC::TC("qpdf", "QPDFWriter original obj non-zero gen");
-                        writeString(" " + std::to_string(obj.getGen()));
+            int count = -1;
+            for (auto const& obj: m->object_stream_to_objects[old_id]) {
+                ++count;
+                int new_obj = m->obj[obj].renumber;
+                if (first_obj == -1) {
+                    first_obj = new_obj;
+                }
+                if (m->qdf_mode) {
+                    writeString(
+                        "%% Object stream: object " + std::to_string(new_obj) + ", index " +
+                        std::to_string(count));
+                    if (!m->suppress_original_object_ids) {
+                        writeString("; original object ID: " + std::to_string(obj.getObj()));
+                        // For compatibility, only write the generation if non-zero.  While
+                        // object streams only allow objects with generation 0, if we are
+                        // generating object streams, the old object could have a non-zero
+                        // generation.
+                        if (obj.getGen() != 0) {
+                            QTC::TC("qpdf", "QPDFWriter original obj non-zero gen");
+                            writeString(" " + std::to_string(obj.getGen()));
+                        }
                     }
+                    writeString("\n");
                 }
-                writeString("\n");
-            }
-            if (pass == 1) {
-                offsets.push_back(m->pipeline->getCount());
-                // To avoid double-counting objects being written in object streams for progress
-                // reporting, decrement in pass 1.
-                indicateProgress(true, false);
-            }
-            QPDFObjectHandle obj_to_write = m->pdf.getObject(obj);
-            if (obj_to_write.isStream()) {
-                // This condition occurred in a fuzz input. Ideally we should block it at parse
-                // time, but it's not clear to me how to construct a case for this.
-                obj_to_write.warnIfPossible("stream found inside object stream; treating as null");
-                obj_to_write = QPDFObjectHandle::newNull();
+                if (pass == 1) {
+                    offsets.push_back(m->pipeline->getCount());
+                    // To avoid double-counting objects being written in object streams for
+                    // progress reporting, decrement in pass 1.
+                    indicateProgress(true, false);
+                }
+                QPDFObjectHandle obj_to_write = m->pdf.getObject(obj);
+                if (obj_to_write.isStream()) {
+                    // This condition occurred in a fuzz input. Ideally we should block it at
+                    // parse time, but it's not clear to me how to construct a case for this.
+                    obj_to_write.warnIfPossible(
+                        "stream found inside object stream; treating as null");
+                    obj_to_write = QPDFObjectHandle::newNull();
+                    // Write the stream again in the second pass so that the warning is repeated.
+                    warned = true;
+                }
+                writeObject(obj_to_write, count);
+                if (pass == 2 && m->release_written_objects) {
+                    QPDF::Writer::release(m->pdf, obj);
+                }
+
+                m->new_obj[new_obj].xref = QPDFXRefEntry(new_stream_id, count);
             }
-            writeObject(obj_to_write, count);
+        }
 
-            m->new_obj[new_obj].xref = QPDFXRefEntry(new_stream_id, count);
+        if (compressed) {
+            Pl_Buffer out("compressed object stream");
+            Pl_Flate("compress object stream", &out, Pl_Flate::a_deflate)
+                .writeAll(stream_buffer->getBuffer(), stream_buffer->getSize());
+            stream_buffer = out.getBufferSharedPointer();
+        }
+
+        n = offsets.size();
+        if (m->fill_lin_cache && !warned) {
+            Members::CachedObjectStream entry{{}, n, first, compressed};
+            if (m->lin_cache.store(stream_buffer, entry.data)) {
+                m->lin_object_streams[old_id] = std::move(entry);
+            }
         }
     }
 
@@ -1721,7 +2069,7 @@ QPDFWriter::writeObjectStream(QPDFObjectHandle object)
     if (compressed) {
         writeString(" /Filter /FlateDecode");
     }
-    writeString(" /N " + std::to_string(offsets.size()));
+    writeString(" /N " + std::to_string(n));
     writeStringQDF("\n ");
     writeString(" /First " + std::to_string(first));
     if (!object.isNull()) {
@@ -1916,13 +2264,13 @@ QPDFWriter::initializeSpecialStreams()
         m->page_object_to_seq[page.getObjGen()] = ++num;
         QPDFObjectHandle contents = page.getKey("/Contents");
         std::vector<QPDFObjGen> contents_objects;
-        if (contents.isArray()) {
+        if (QPDF::Writer::isStream(m->pdf, contents)) {
+            contents_objects.push_back(contents.getObjGen());
+        } else if (contents.isArray()) {
             int n = contents.getArrayNItems();
             for (int i = 0; i < n; ++i) {
                 contents_objects.push_back(contents.getArrayItem(i).getObjGen());
             }
-        } else if (contents.isStream()) {
-            contents_objects.push_back(contents.getObjGen());
         }
 
         for (auto const& c: contents_objects) {
@@ -2119,7 +2467,11 @@ QPDFWriter::doWriteSetup()
         initializeSpecialStreams();
     }
 
-    if (m->qdf_mode) {
+    if (m->compression_threads > 1) {
+        m->worker_pool = std::make_unique<WorkerPool>(QIntC::to_size(m->compression_threads));
+    }
+
+    if (m->qdf_mode || (m->indirect_stream_lengths && !m->linearized && !m->pclm)) {
         // Generate indirect stream lengths for qdf mode since fix-qdf uses them for storing
         // recomputed stream length data. Certain streams such as object streams, xref streams, and
         // hint streams always get direct stream lengths.
@@ -2198,6 +2550,32 @@ QPDFWriter::doWriteSetup()
 void
 QPDFWriter::write()
 {
+    // Objects are only released during this call. Afterwards they may be changed again.
+    struct ReleaseScope
+    {
+        ~ReleaseScope()
+        {
+            if (pdf) {
+                QPDF::Writer::stopRelease(*pdf);
+            }
+        }
+        QPDF* pdf{nullptr};
+    } release_scope;
+    if (m->release_written_objects && !m->linearized && !m->pclm) {
+        // Objects that are modified while setting up the write must not be released, so make sure
+        // the modifications happen before the unresolved objects are recorded. The document
+        // catalog may be repaired when it is first accessed and is changed by
+        // prepareFileForWrite, and the pages tree may be repaired by the first call to
+        // getAllPages.
+        m->pdf.getRoot();
+        if (m->qdf_mode || m->normalize_content || m->stream_decode_level) {
+            m->pdf.getAllPages();
+        }
+        QPDF::Writer::startRelease(m->pdf);
+        release_scope.pdf = &m->pdf;
+    }
+
+    m->lin_phase_start = std::chrono::steady_clock::now();
     doWriteSetup();
 
     // Set up progress reporting. For linearized files, we write two passes. events_expected is an
@@ -2520,16 +2898,37 @@ QPDFWriter::calculateXrefStreamPadding(qpdf_offset_t xref_bytes)
 void
 QPDFWriter::writeLinearized()
 {
+    auto end_phase = [this](std::string const& phase) {
+        if (m->lin_timer) {
+            auto now = std::chrono::steady_clock::now();
+            m->lin_timer(phase, std::chrono::duration<double>(now - m->lin_phase_start).count());
+            m->lin_phase_start = now;
+        }
+    };
+    end_phase("prepare");
+
     // Optimize file and enqueue objects in order
 
     std::map<int, int> stream_cache;
 
+    // Finding out whether a stream will be filtered may require filtering it. Keep the data so that
+    // it doesn't have to be filtered again when it is written.
+    m->fill_lin_cache = m->lin_cache.memory_limit > 0 || m->lin_cache.use_file;
+    if (m->lin_cache.use_file && !m->lin_cache.openFile()) {
+        m->pdf.warn(
+            qpdf_e_system,
+            "",
+            0,
+            "unable to create a temporary file for the linearization cache; data that doesn't fit "
+            "in memory will be computed again");
+    }
     auto skip_stream_parameters = [this, &stream_cache](QPDFObjectHandle& stream) {
         auto& result = stream_cache[stream.getObjectID()];
         if (result == 0) {
             bool compress_stream;
             bool is_metadata;
-            if (willFilterStream(stream, compress_stream, is_metadata, nullptr)) {
+            std::shared_ptr<Buffer> stream_data;
+            if (willFilterStream(stream, compress_stream, is_metadata, &stream_data, false, true)) {
                 result = 2;
             } else {
                 result = 1;
@@ -2539,6 +2938,7 @@ QPDFWriter::writeLinearized()
     };
 
     QPDF::Writer::optimize(m->pdf, m->obj, skip_stream_parameters);
+    end_phase("optimize");
 
     std::vector<QPDFObjectHandle> part4;
     std::vector<QPDFObjectHandle> part6;
@@ -2640,6 +3040,8 @@ QPDFWriter::writeLinearized()
         throw std::runtime_error("error encountered after writing part 9 of linearized data");
     }
 
+    end_phase("order objects");
+
     qpdf_offset_t hint_length = 0;
     std::shared_ptr<Buffer> hint_buffer;
 
@@ -2772,7 +3174,10 @@ QPDFWriter::writeLinearized()
 
         // Parts 4 through 9
 
+        clearPrefilteredStreams();
+        size_t queue_index = 0;
         for (auto const& cur_object: m->object_queue) {
+            prefilterStreams(queue_index++);
             if (cur_object.getObjectID() == part6_end_marker) {
                 first_half_max_obj_offset = m->pipeline->getCount();
             }
@@ -2853,6 +3258,7 @@ QPDFWriter::writeLinearized()
             // Close first pass pipeline
             file_size = m->pipeline->getCount();
             pp_pass1 = nullptr;
+            end_phase("first pass");
 
             // Save hint offset since it will be set to zero by calling openObject.
             qpdf_offset_t hint_offset1 = m->new_obj[hint_id].xref.getOffset();
@@ -2884,8 +3290,16 @@ QPDFWriter::writeLinearized()
                 fclose(lin_pass1_file);
                 lin_pass1_file = nullptr;
             }
+            end_phase("hint stream");
+
+            // From here on, cached data is used once and then dropped.
+            m->fill_lin_cache = false;
         }
     }
+    m->lin_streams.clear();
+    m->lin_object_streams.clear();
+    m->lin_cache.clear();
+    end_phase("second pass");
 }
 
 void
@@ -2993,9 +3407,13 @@ QPDFWriter::writeStandard()
 
     // Now start walking queue, outputting each object.
     while (m->object_queue_front < m->object_queue.size()) {
+        prefilterStreams(m->object_queue_front);
         QPDFObjectHandle cur_object = m->object_queue.at(m->object_queue_front);
         ++m->object_queue_front;
         writeObject(cur_object);
+        if (m->release_written_objects) {
+            QPDF::Writer::release(m->pdf, cur_object.getObjGen());
+        }
     }
 
     // Write out the encryption dictionary, if any
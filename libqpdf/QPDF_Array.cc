@@ -8,7 +8,7 @@
 static const QPDFObjectHandle null_oh = QPDFObjectHandle::newNull();
 
 inline void
-QPDF_Array::checkOwnership(QPDFObjectHandle const& item) const
+QPDF_Array::checkOwnership(QPDF* qpdf, QPDFObjectHandle const& item)
 {
     if (auto obj = item.getObjectPtr()) {
         if (qpdf) {
@@ -25,25 +25,17 @@ QPDF_Array::checkOwnership(QPDFObjectHandle const& item) const
     }
 }
 
-QPDF_Array::QPDF_Array() :
-    QPDFValue(::ot_array)
-{
-}
-
 QPDF_Array::QPDF_Array(QPDF_Array const& other) :
-    QPDFValue(::ot_array),
     sp(other.sp ? std::make_unique<Sparse>(*other.sp) : nullptr)
 {
 }
 
-QPDF_Array::QPDF_Array(std::vector<QPDFObjectHandle> const& v) :
-    QPDFValue(::ot_array)
+QPDF_Array::QPDF_Array(std::vector<QPDFObjectHandle> const& v)
 {
-    setFromVector(v);
+    setFromVector(v, nullptr);
 }
 
-QPDF_Array::QPDF_Array(std::vector<std::shared_ptr<QPDFObject>>&& v, bool sparse) :
-    QPDFValue(::ot_array)
+QPDF_Array::QPDF_Array(std::vector<std::shared_ptr<QPDFObject>>&& v, bool sparse)
 {
     if (sparse) {
         sp = std::make_unique<Sparse>();
@@ -61,32 +53,32 @@ QPDF_Array::QPDF_Array(std::vector<std::shared_ptr<QPDFObject>>&& v, bool sparse
 std::shared_ptr<QPDFObject>
 QPDF_Array::create(std::vector<QPDFObjectHandle> const& items)
 {
-    return do_create(new QPDF_Array(items));
+    return std::make_shared<QPDFObject>(QPDF_Array(items));
 }
 
 std::shared_ptr<QPDFObject>
 QPDF_Array::create(std::vector<std::shared_ptr<QPDFObject>>&& items, bool sparse)
 {
-    return do_create(new QPDF_Array(std::move(items), sparse));
+    return std::make_shared<QPDFObject>(QPDF_Array(std::move(items), sparse));
 }
 
 std::shared_ptr<QPDFObject>
 QPDF_Array::copy(bool shallow)
 {
     if (shallow) {
-        return do_create(new QPDF_Array(*this));
+        return std::make_shared<QPDFObject>(QPDF_Array(*this));
     } else {
         QTC::TC("qpdf", "QPDF_Array copy", sp ? 0 : 1);
         if (sp) {
-            auto* result = new QPDF_Array();
-            result->sp = std::make_unique<Sparse>();
-            result->sp->size = sp->size;
+            QPDF_Array result;
+            result.sp = std::make_unique<Sparse>();
+            result.sp->size = sp->size;
             for (auto const& element: sp->elements) {
                 auto const& obj = element.second;
-                result->sp->elements[element.first] =
+                result.sp->elements[element.first] =
                     obj->getObjGen().isIndirect() ? obj : obj->copy();
             }
-            return do_create(result);
+            return std::make_shared<QPDFObject>(std::move(result));
         } else {
             std::vector<std::shared_ptr<QPDFObject>> result;
             result.reserve(elements.size());
@@ -215,12 +207,12 @@ QPDF_Array::getAsVector() const
 }
 
 bool
-QPDF_Array::setAt(int at, QPDFObjectHandle const& oh)
+QPDF_Array::setAt(int at, QPDFObjectHandle const& oh, QPDF* qpdf)
 {
     if (at < 0 || at >= size()) {
         return false;
     }
-    checkOwnership(oh);
+    checkOwnership(qpdf, oh);
     if (sp) {
         sp->elements[at] = oh.getObj();
     } else {
@@ -230,27 +222,27 @@ QPDF_Array::setAt(int at, QPDFObjectHandle const& oh)
 }
 
 void
-QPDF_Array::setFromVector(std::vector<QPDFObjectHandle> const& v)
+QPDF_Array::setFromVector(std::vector<QPDFObjectHandle> const& v, QPDF* qpdf)
 {
     elements.resize(0);
     elements.reserve(v.size());
     for (auto const& item: v) {
-        checkOwnership(item);
+        checkOwnership(qpdf, item);
         elements.push_back(item.getObj());
     }
 }
 
 bool
-QPDF_Array::insert(int at, QPDFObjectHandle const& item)
+QPDF_Array::insert(int at, QPDFObjectHandle const& item, QPDF* qpdf)
 {
     int sz = size();
     if (at < 0 || at > sz) {
         // As special case, also allow insert beyond the end
         return false;
     } else if (at == sz) {
-        push_back(item);
+        push_back(item, qpdf);
     } else {
-        checkOwnership(item);
+        checkOwnership(qpdf, item);
         if (sp) {
             auto iter = sp->elements.crbegin();
             while (iter != sp->elements.crend()) {
@@ -273,9 +265,9 @@ QPDF_Array::insert(int at, QPDFObjectHandle const& item)
 }
 
 void
-QPDF_Array::push_back(QPDFObjectHandle const& item)
+QPDF_Array::push_back(QPDFObjectHandle const& item, QPDF* qpdf)
 {
-    checkOwnership(item);
+    checkOwnership(qpdf, item);
     if (sp) {
         sp->elements[(sp->size)++] = item.getObj();
     } else {
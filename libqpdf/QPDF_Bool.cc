@@ -1,9 +1,9 @@
 #include <qpdf/QPDF_Bool.hh>
 
 #include <qpdf/JSON_writer.hh>
+#include <qpdf/QPDFObject_private.hh>
 
 QPDF_Bool::QPDF_Bool(bool val) :
-    QPDFValue(::ot_boolean),
     val(val)
 {
 }
@@ -11,7 +11,7 @@ QPDF_Bool::QPDF_Bool(bool val) :
 std::shared_ptr<QPDFObject>
 QPDF_Bool::create(bool value)
 {
-    return do_create(new QPDF_Bool(value));
+    return std::make_shared<QPDFObject>(QPDF_Bool(value));
 }
 
 std::shared_ptr<QPDFObject>
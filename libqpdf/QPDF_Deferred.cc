@@ -0,0 +1,12 @@
+#include <qpdf/QPDF_Deferred.hh>
+
+#include <qpdf/QPDFObject_private.hh>
+
+std::shared_ptr<QPDFObject>
+QPDF_Deferred::create(
+    std::shared_ptr<QPDF::DeferredInput> input,
+    qpdf_offset_t offset,
+    qpdf_object_type_e type_code)
+{
+    return std::make_shared<QPDFObject>(QPDF_Deferred{std::move(input), offset, type_code});
+}
@@ -1,18 +1,8 @@
 #include <qpdf/QPDF_Destroyed.hh>
 
-#include <stdexcept>
-
-QPDF_Destroyed::QPDF_Destroyed() :
-    QPDFValue(::ot_destroyed)
-{
-}
+#include <qpdf/QPDFObject_private.hh>
 
-std::shared_ptr<QPDFValue>
-QPDF_Destroyed::getInstance()
-{
-    static std::shared_ptr<QPDFValue> instance(new QPDF_Destroyed());
-    return instance;
-}
+#include <stdexcept>
 
 std::shared_ptr<QPDFObject>
 QPDF_Destroyed::copy(bool shallow)
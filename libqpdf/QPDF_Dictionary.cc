@@ -3,67 +3,136 @@
 #include <qpdf/JSON_writer.hh>
 #include <qpdf/QPDFObject_private.hh>
 #include <qpdf/QPDF_Name.hh>
-#include <qpdf/QPDF_Null.hh>
 #include <qpdf/QUtil.hh>
 
+#include <algorithm>
+
 using namespace std::literals;
 
-QPDF_Dictionary::QPDF_Dictionary(std::map<std::string, QPDFObjectHandle> const& items) :
-    QPDFValue(::ot_dictionary),
-    items(items)
+QPDF_Dictionary::Items::Items(Items const& other) :
+    small(other.small),
+    large(other.large ? std::make_unique<std::map<NameAtom, QPDFObjectHandle, std::less<>>>(
+                            *other.large)
+                      : nullptr)
+{
+}
+
+QPDF_Dictionary::Items::Small::iterator
+QPDF_Dictionary::Items::lower_bound(std::string_view key)
+{
+    return std::lower_bound(small.begin(), small.end(), key, [](auto const& item, auto k) {
+        return item.first < k;
+    });
+}
+
+QPDFObjectHandle*
+QPDF_Dictionary::Items::find(std::string_view key)
+{
+    if (large) {
+        auto item = large->find(key);
+        return item == large->end() ? nullptr : &item->second;
+    }
+    auto item = lower_bound(key);
+    return (item == small.end() || item->first != key) ? nullptr : &item->second;
+}
+
+bool
+QPDF_Dictionary::Items::insert_or_assign(NameAtom const& key, QPDFObjectHandle value)
+{
+    if (large) {
+        return large->insert_or_assign(key, std::move(value)).second;
+    }
+    // Keys are usually added in order, so check the end first.
+    auto item = (small.empty() || small.back().first < key) ? small.end() : lower_bound(key.str());
+    if (item != small.end() && item->first == key) {
+        item->second = std::move(value);
+        return false;
+    }
+    if (small.size() < large_size) {
+        small.emplace(item, key, std::move(value));
+    } else {
+        large = std::make_unique<std::map<NameAtom, QPDFObjectHandle, std::less<>>>(
+            std::make_move_iterator(small.begin()), std::make_move_iterator(small.end()));
+        small = Small();
+        large->emplace(key, std::move(value));
+    }
+    return true;
+}
+
+bool
+QPDF_Dictionary::Items::insert_or_assign(std::string_view key, QPDFObjectHandle value)
+{
+    if (auto existing = find(key)) {
+        *existing = std::move(value);
+        return false;
+    }
+    return insert_or_assign(NameAtom(key), std::move(value));
+}
+
+void
+QPDF_Dictionary::Items::erase(std::string_view key)
 {
+    if (large) {
+        if (auto item = large->find(key); item != large->end()) {
+            large->erase(item);
+        }
+    } else if (auto item = lower_bound(key); item != small.end() && item->first == key) {
+        small.erase(item);
+    }
 }
 
-QPDF_Dictionary::QPDF_Dictionary(std::map<std::string, QPDFObjectHandle>&& items) :
-    QPDFValue(::ot_dictionary),
-    items(items)
+QPDF_Dictionary::QPDF_Dictionary(Items&& items) :
+    items(std::move(items))
 {
 }
 
 std::shared_ptr<QPDFObject>
 QPDF_Dictionary::create(std::map<std::string, QPDFObjectHandle> const& items)
 {
-    return do_create(new QPDF_Dictionary(items));
+    Items new_items;
+    for (auto const& item: items) {
+        new_items.insert_or_assign(NameAtom(item.first), item.second);
+    }
+    return create(std::move(new_items));
 }
 
 std::shared_ptr<QPDFObject>
-QPDF_Dictionary::create(std::map<std::string, QPDFObjectHandle>&& items)
+QPDF_Dictionary::create(Items&& items)
 {
-    return do_create(new QPDF_Dictionary(items));
+    return std::make_shared<QPDFObject>(QPDF_Dictionary(std::move(items)));
 }
 
 std::shared_ptr<QPDFObject>
 QPDF_Dictionary::copy(bool shallow)
 {
-    if (shallow) {
-        return create(items);
-    } else {
-        std::map<std::string, QPDFObjectHandle> new_items;
-        for (auto const& item: this->items) {
-            auto value = item.second;
-            new_items[item.first] = value.isIndirect() ? value : value.shallowCopy();
-        }
-        return create(new_items);
+    Items new_items = items;
+    if (!shallow) {
+        new_items.for_each([](auto const&, QPDFObjectHandle& value) {
+            if (!value.isIndirect()) {
+                value = value.shallowCopy();
+            }
+        });
     }
+    return create(std::move(new_items));
 }
 
 void
 QPDF_Dictionary::disconnect()
 {
-    for (auto& iter: this->items) {
-        QPDFObjectHandle::DisconnectAccess::disconnect(iter.second);
-    }
+    items.for_each([](auto const&, QPDFObjectHandle& value) {
+        QPDFObjectHandle::DisconnectAccess::disconnect(value);
+    });
 }
 
 std::string
 QPDF_Dictionary::unparse()
 {
     std::string result = "<< ";
-    for (auto& iter: this->items) {
-        if (!iter.second.isNull()) {
-            result += QPDF_Name::normalizeName(iter.first) + " " + iter.second.unparse() + " ";
+    items.for_each([&result](NameAtom const& key, QPDFObjectHandle& value) {
+        if (!value.isNull()) {
+            result += QPDF_Name::normalizeName(key) + " " + value.unparse() + " ";
         }
-    }
+    });
     result += ">>";
     return result;
 }
@@ -72,64 +141,54 @@ void
 QPDF_Dictionary::writeJSON(int json_version, JSON::Writer& p)
 {
     p.writeStart('{');
-    for (auto& iter: this->items) {
-        if (!iter.second.isNull()) {
+    items.for_each([json_version, &p](NameAtom const& key, QPDFObjectHandle& value) {
+        if (!value.isNull()) {
             p.writeNext();
             if (json_version == 1) {
-                p << "\"" << JSON::Writer::encode_string(QPDF_Name::normalizeName(iter.first))
-                  << "\": ";
-            } else if (auto res = QPDF_Name::analyzeJSONEncoding(iter.first); res.first) {
+                p << "\"" << JSON::Writer::encode_string(QPDF_Name::normalizeName(key)) << "\": ";
+            } else if (auto res = QPDF_Name::analyzeJSONEncoding(key); res.first) {
                 if (res.second) {
-                    p << "\"" << iter.first << "\": ";
+                    p << "\"" << key.str() << "\": ";
                 } else {
-                    p << "\"" << JSON::Writer::encode_string(iter.first) << "\": ";
+                    p << "\"" << JSON::Writer::encode_string(key) << "\": ";
                 }
             } else {
-                p << "\"n:" << JSON::Writer::encode_string(QPDF_Name::normalizeName(iter.first))
+                p << "\"n:" << JSON::Writer::encode_string(QPDF_Name::normalizeName(key))
                   << "\": ";
             }
-            iter.second.writeJSON(json_version, p);
+            value.writeJSON(json_version, p);
         }
-    }
+    });
     p.writeEnd('}');
 }
 
 bool
 QPDF_Dictionary::hasKey(std::string const& key)
 {
-    return ((this->items.count(key) > 0) && (!this->items[key].isNull()));
-}
-
-QPDFObjectHandle
-QPDF_Dictionary::getKey(std::string const& key)
-{
-    // PDF spec says fetching a non-existent key from a dictionary returns the null object.
-    auto item = this->items.find(key);
-    if (item != this->items.end()) {
-        // May be a null object
-        return item->second;
-    } else {
-        static auto constexpr msg = " -> dictionary key $VD"sv;
-        return QPDF_Null::create(shared_from_this(), msg, key);
-    }
+    auto value = items.find(key);
+    return value && !value->isNull();
 }
 
 std::set<std::string>
 QPDF_Dictionary::getKeys()
 {
     std::set<std::string> result;
-    for (auto& iter: this->items) {
-        if (!iter.second.isNull()) {
-            result.insert(iter.first);
+    items.for_each([&result](NameAtom const& key, QPDFObjectHandle& value) {
+        if (!value.isNull()) {
+            result.insert(result.end(), key);
         }
-    }
+    });
     return result;
 }
 
-std::map<std::string, QPDFObjectHandle> const&
-QPDF_Dictionary::getAsMap() const
+std::map<std::string, QPDFObjectHandle>
+QPDF_Dictionary::getAsMap()
 {
-    return this->items;
+    std::map<std::string, QPDFObjectHandle> result;
+    items.for_each([&result](NameAtom const& key, QPDFObjectHandle& value) {
+        result.emplace_hint(result.end(), key, value);
+    });
+    return result;
 }
 
 void
@@ -141,8 +200,7 @@ QPDF_Dictionary::replaceKey(std::string const& key, QPDFObjectHandle value)
         // spec.
         removeKey(key);
     } else {
-        // add or replace value
-        this->items[key] = value;
+        items.insert_or_assign(std::string_view(key), value);
     }
 }
 
@@ -150,5 +208,5 @@ void
 QPDF_Dictionary::removeKey(std::string const& key)
 {
     // no-op if key does not exist
-    this->items.erase(key);
+    items.erase(key);
 }
@@ -1,9 +1,9 @@
 #include <qpdf/QPDF_InlineImage.hh>
 
 #include <qpdf/JSON_writer.hh>
+#include <qpdf/QPDFObject_private.hh>
 
 QPDF_InlineImage::QPDF_InlineImage(std::string const& val) :
-    QPDFValue(::ot_inlineimage),
     val(val)
 {
 }
@@ -11,7 +11,7 @@ QPDF_InlineImage::QPDF_InlineImage(std::string const& val) :
 std::shared_ptr<QPDFObject>
 QPDF_InlineImage::create(std::string const& val)
 {
-    return do_create(new QPDF_InlineImage(val));
+    return std::make_shared<QPDFObject>(QPDF_InlineImage(val));
 }
 
 std::shared_ptr<QPDFObject>
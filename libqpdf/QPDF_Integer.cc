@@ -1,10 +1,10 @@
 #include <qpdf/QPDF_Integer.hh>
 
 #include <qpdf/JSON_writer.hh>
+#include <qpdf/QPDFObject_private.hh>
 #include <qpdf/QUtil.hh>
 
 QPDF_Integer::QPDF_Integer(long long val) :
-    QPDFValue(::ot_integer),
     val(val)
 {
 }
@@ -12,7 +12,7 @@ QPDF_Integer::QPDF_Integer(long long val) :
 std::shared_ptr<QPDFObject>
 QPDF_Integer::create(long long value)
 {
-    return do_create(new QPDF_Integer(value));
+    return std::make_shared<QPDFObject>(QPDF_Integer(value));
 }
 
 std::shared_ptr<QPDFObject>
@@ -1,24 +1,29 @@
 #include <qpdf/QPDF_Name.hh>
 
 #include <qpdf/JSON_writer.hh>
+#include <qpdf/QPDFObject_private.hh>
 #include <qpdf/QUtil.hh>
 
-QPDF_Name::QPDF_Name(std::string const& name) :
-    QPDFValue(::ot_name),
+QPDF_Name::QPDF_Name(std::string_view name) :
+    name(name)
+{
+}
+
+QPDF_Name::QPDF_Name(NameAtom const& name) :
     name(name)
 {
 }
 
 std::shared_ptr<QPDFObject>
-QPDF_Name::create(std::string const& name)
+QPDF_Name::create(std::string_view name)
 {
-    return do_create(new QPDF_Name(name));
+    return std::make_shared<QPDFObject>(QPDF_Name(name));
 }
 
 std::shared_ptr<QPDFObject>
 QPDF_Name::copy(bool shallow)
 {
-    return create(name);
+    return std::make_shared<QPDFObject>(QPDF_Name(name));
 }
 
 std::string
@@ -109,7 +114,7 @@ QPDF_Name::writeJSON(int json_version, JSON::Writer& p)
     } else {
         if (auto res = analyzeJSONEncoding(name); res.first) {
             if (res.second) {
-                p << "\"" << name << "\"";
+                p << "\"" << name.str() << "\"";
             } else {
                 p << "\"" << JSON::Writer::encode_string(name) << "\"";
             }
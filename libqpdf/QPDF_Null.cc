@@ -3,31 +3,17 @@
 #include <qpdf/JSON_writer.hh>
 #include <qpdf/QPDFObject_private.hh>
 
-QPDF_Null::QPDF_Null(QPDF* qpdf, QPDFObjGen og) :
-    QPDFValue(::ot_null, qpdf, og)
-{
-}
-
 std::shared_ptr<QPDFObject>
 QPDF_Null::create(QPDF* qpdf, QPDFObjGen og)
 {
-    return do_create(new QPDF_Null(qpdf, og));
+    return std::make_shared<QPDFObject>(qpdf, og, QPDF_Null());
 }
 
 std::shared_ptr<QPDFObject>
 QPDF_Null::create(
     std::shared_ptr<QPDFObject> parent, std::string_view const& static_descr, std::string var_descr)
 {
-    auto n = do_create(new QPDF_Null());
-    n->setChildDescription(parent, static_descr, var_descr);
-    return n;
-}
-
-std::shared_ptr<QPDFObject>
-QPDF_Null::create(
-    std::shared_ptr<QPDFValue> parent, std::string_view const& static_descr, std::string var_descr)
-{
-    auto n = do_create(new QPDF_Null());
+    auto n = std::make_shared<QPDFObject>(QPDF_Null());
     n->setChildDescription(parent, static_descr, var_descr);
     return n;
 }
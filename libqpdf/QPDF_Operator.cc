@@ -1,17 +1,17 @@
 #include <qpdf/QPDF_Operator.hh>
 
 #include <qpdf/JSON_writer.hh>
+#include <qpdf/QPDFObject_private.hh>
 
-QPDF_Operator::QPDF_Operator(std::string const& val) :
-    QPDFValue(::ot_operator),
+QPDF_Operator::QPDF_Operator(std::string_view val) :
     val(val)
 {
 }
 
 std::shared_ptr<QPDFObject>
-QPDF_Operator::create(std::string const& val)
+QPDF_Operator::create(std::string_view val)
 {
-    return do_create(new QPDF_Operator(val));
+    return std::make_shared<QPDFObject>(QPDF_Operator(val));
 }
 
 std::shared_ptr<QPDFObject>
@@ -1,30 +1,29 @@
 #include <qpdf/QPDF_Real.hh>
 
 #include <qpdf/JSON_writer.hh>
+#include <qpdf/QPDFObject_private.hh>
 #include <qpdf/QUtil.hh>
 
-QPDF_Real::QPDF_Real(std::string const& val) :
-    QPDFValue(::ot_real),
+QPDF_Real::QPDF_Real(std::string_view val) :
     val(val)
 {
 }
 
 QPDF_Real::QPDF_Real(double value, int decimal_places, bool trim_trailing_zeroes) :
-    QPDFValue(::ot_real),
     val(QUtil::double_to_string(value, decimal_places, trim_trailing_zeroes))
 {
 }
 
 std::shared_ptr<QPDFObject>
-QPDF_Real::create(std::string const& val)
+QPDF_Real::create(std::string_view val)
 {
-    return do_create(new QPDF_Real(val));
+    return std::make_shared<QPDFObject>(QPDF_Real(val));
 }
 
 std::shared_ptr<QPDFObject>
 QPDF_Real::create(double value, int decimal_places, bool trim_trailing_zeroes)
 {
-    return do_create(new QPDF_Real(value, decimal_places, trim_trailing_zeroes));
+    return std::make_shared<QPDFObject>(QPDF_Real(value, decimal_places, trim_trailing_zeroes));
 }
 
 std::shared_ptr<QPDFObject>
@@ -1,16 +1,13 @@
 #include <qpdf/QPDF_Reserved.hh>
 
-#include <stdexcept>
+#include <qpdf/QPDFObject_private.hh>
 
-QPDF_Reserved::QPDF_Reserved() :
-    QPDFValue(::ot_reserved)
-{
-}
+#include <stdexcept>
 
 std::shared_ptr<QPDFObject>
 QPDF_Reserved::create()
 {
-    return do_create(new QPDF_Reserved());
+    return std::make_shared<QPDFObject>(QPDF_Reserved());
 }
 
 std::shared_ptr<QPDFObject>
@@ -11,6 +11,7 @@
 #include <qpdf/Pl_QPDFTokenizer.hh>
 #include <qpdf/QIntC.hh>
 #include <qpdf/QPDFExc.hh>
+#include <qpdf/QPDFObject_private.hh>
 #include <qpdf/QPDF_private.hh>
 #include <qpdf/QTC.hh>
 #include <qpdf/QUtil.hh>
@@ -60,11 +61,11 @@ namespace
     class StreamBlobProvider
     {
       public:
-        StreamBlobProvider(QPDF_Stream* stream, qpdf_stream_decode_level_e decode_level);
+        StreamBlobProvider(QPDFObject* stream, qpdf_stream_decode_level_e decode_level);
         void operator()(Pipeline*);
 
       private:
-        QPDF_Stream* stream;
+        QPDFObject* stream;
         qpdf_stream_decode_level_e decode_level;
     };
 } // namespace
@@ -94,7 +95,7 @@ std::map<std::string, std::function<std::shared_ptr<QPDFStreamFilter>()>>
 };
 
 StreamBlobProvider::StreamBlobProvider(
-    QPDF_Stream* stream, qpdf_stream_decode_level_e decode_level) :
+    QPDFObject* stream, qpdf_stream_decode_level_e decode_level) :
     stream(stream),
     decode_level(decode_level)
 {
@@ -103,30 +104,33 @@ StreamBlobProvider::StreamBlobProvider(
 void
 StreamBlobProvider::operator()(Pipeline* p)
 {
-    this->stream->pipeStreamData(p, nullptr, 0, decode_level, false, false);
+    this->stream->as<QPDF_Stream>()->pipeStreamData(p, nullptr, 0, decode_level, false, false);
 }
 
-QPDF_Stream::QPDF_Stream(
-    QPDF* qpdf, QPDFObjGen og, QPDFObjectHandle stream_dict, qpdf_offset_t offset, size_t length) :
-    QPDFValue(::ot_stream, qpdf, og),
-    filter_on_write(true),
+QPDF_Stream::Members::Members(QPDFObjectHandle stream_dict, size_t length) :
     stream_dict(stream_dict),
     length(length)
+{
+}
+
+QPDF_Stream::QPDF_Stream(QPDFObjectHandle stream_dict, size_t length) :
+    m(std::make_unique<Members>(stream_dict, length))
 {
     if (!stream_dict.isDictionary()) {
         throw std::logic_error(
             "stream object instantiated with non-dictionary object for dictionary");
     }
-    auto descr = std::make_shared<QPDFValue::Description>(
-        qpdf->getFilename() + ", stream object " + og.unparse(' '));
-    setDescription(qpdf, descr, offset);
 }
 
 std::shared_ptr<QPDFObject>
 QPDF_Stream::create(
     QPDF* qpdf, QPDFObjGen og, QPDFObjectHandle stream_dict, qpdf_offset_t offset, size_t length)
 {
-    return do_create(new QPDF_Stream(qpdf, og, stream_dict, offset, length));
+    auto result = std::make_shared<QPDFObject>(qpdf, og, QPDF_Stream(stream_dict, length));
+    auto descr = std::make_shared<QPDFObject::Description>(
+        qpdf->getFilename() + ", stream object " + og.unparse(' '));
+    result->setDescription(qpdf, descr, offset);
+    return result;
 }
 
 std::shared_ptr<QPDFObject>
@@ -146,33 +150,33 @@ QPDF_Stream::registerStreamFilter(
 void
 QPDF_Stream::setFilterOnWrite(bool val)
 {
-    this->filter_on_write = val;
+    m->filter_on_write = val;
 }
 
 bool
 QPDF_Stream::getFilterOnWrite() const
 {
-    return this->filter_on_write;
+    return m->filter_on_write;
 }
 
 void
 QPDF_Stream::disconnect()
 {
-    this->stream_provider = nullptr;
-    QPDFObjectHandle::DisconnectAccess::disconnect(this->stream_dict);
+    m->stream_provider = nullptr;
+    QPDFObjectHandle::DisconnectAccess::disconnect(m->stream_dict);
 }
 
 std::string
 QPDF_Stream::unparse()
 {
     // Unparse stream objects as indirect references
-    return og.unparse(' ') + " R";
+    return m->obj->getObjGen().unparse(' ') + " R";
 }
 
 void
 QPDF_Stream::writeJSON(int json_version, JSON::Writer& jw)
 {
-    stream_dict.writeJSON(json_version, jw);
+    m->stream_dict.writeJSON(json_version, jw);
 }
 
 JSON
@@ -190,7 +194,8 @@ QPDF_Stream::getStreamJSON(
     pb.finish();
     auto result = JSON::parse(pb.getString());
     if (json_data == qpdf_sj_inline) {
-        result.addDictionaryMember("data", JSON::makeBlob(StreamBlobProvider(this, decode_level)));
+        result.addDictionaryMember(
+            "data", JSON::makeBlob(StreamBlobProvider(m->obj, decode_level)));
     }
     return result;
 }
@@ -230,7 +235,7 @@ QPDF_Stream::writeStreamJSON(
     if (json_data == qpdf_sj_none) {
         jw.writeNext();
         jw << R"("dict": )";
-        stream_dict.writeJSON(json_version, jw);
+        m->stream_dict.writeJSON(json_version, jw);
         jw.writeEnd('}');
         return decode_level;
     }
@@ -262,7 +267,7 @@ QPDF_Stream::writeStreamJSON(
         throw std::logic_error("QPDF_Stream: failed to get stream data");
     }
     // We can use unsafeShallowCopy because we are only touching top-level keys.
-    auto dict = stream_dict.unsafeShallowCopy();
+    auto dict = m->stream_dict.unsafeShallowCopy();
     dict.removeKey("/Length");
     if (filter && filtered) {
         dict.removeKey("/Filter");
@@ -287,50 +292,55 @@ QPDF_Stream::writeStreamJSON(
     return decode_level;
 }
 
-void
-QPDF_Stream::setDescription(
-    QPDF* qpdf, std::shared_ptr<QPDFValue::Description>& description, qpdf_offset_t offset)
-{
-    this->QPDFValue::setDescription(qpdf, description, offset);
-    setDictDescription();
-}
-
 void
 QPDF_Stream::setDictDescription()
 {
-    if (!this->stream_dict.hasObjectDescription()) {
-        this->stream_dict.setObjectDescription(qpdf, getDescription() + " -> stream dictionary");
+    if (!m->stream_dict.hasObjectDescription()) {
+        m->stream_dict.setObjectDescription(
+            m->obj->getQPDF(), m->obj->getDescription() + " -> stream dictionary");
     }
 }
 
 QPDFObjectHandle
 QPDF_Stream::getDict() const
 {
-    return this->stream_dict;
+    return m->stream_dict;
 }
 
 bool
 QPDF_Stream::isDataModified() const
 {
-    return (!this->token_filters.empty());
+    return (!m->token_filters.empty());
 }
 
 size_t
 QPDF_Stream::getLength() const
 {
-    return this->length;
+    return m->length;
+}
+
+bool
+QPDF_Stream::getInputDataRange(qpdf_offset_t& offset, size_t& length) const
+{
+    if (m->stream_data || m->stream_provider || !m->token_filters.empty() ||
+        (m->obj->getParsedOffset() <= 0)) {
+        return false;
+    }
+    offset = m->obj->getParsedOffset();
+    length = m->length;
+    return true;
 }
 
 std::shared_ptr<Buffer>
 QPDF_Stream::getStreamDataBuffer() const
 {
-    return this->stream_data;
+    return m->stream_data;
 }
 
 std::shared_ptr<QPDFObjectHandle::StreamDataProvider>
 QPDF_Stream::getStreamDataProvider() const
 {
-    return this->stream_provider;
+    return m->stream_provider;
 }
 
 std::shared_ptr<Buffer>
@@ -342,9 +352,9 @@ QPDF_Stream::getStreamData(qpdf_stream_decode_level_e decode_level)
     if (!filtered) {
         throw QPDFExc(
             qpdf_e_unsupported,
-            qpdf->getFilename(),
+            m->obj->getQPDF()->getFilename(),
             "",
-            this->parsed_offset,
+            m->obj->getParsedOffset(),
             "getStreamData called on unfilterable stream");
     }
     QTC::TC("qpdf", "QPDF_Stream getStreamData");
@@ -358,9 +368,9 @@ QPDF_Stream::getRawStreamData()
     if (!pipeStreamData(&buf, nullptr, 0, qpdf_dl_none, false, false)) {
         throw QPDFExc(
             qpdf_e_unsupported,
-            qpdf->getFilename(),
+            m->obj->getQPDF()->getFilename(),
             "",
-            this->parsed_offset,
+            m->obj->getParsedOffset(),
             "error getting raw stream data");
     }
     QTC::TC("qpdf", "QPDF_Stream getRawStreamData");
@@ -375,7 +385,7 @@ QPDF_Stream::filterable(
 {
     // Check filters
 
-    QPDFObjectHandle filter_obj = this->stream_dict.getKey("/Filter");
+    QPDFObjectHandle filter_obj = m->stream_dict.getKey("/Filter");
     bool filters_okay = true;
 
     std::vector<std::string> filter_names;
@@ -430,7 +440,7 @@ QPDF_Stream::filterable(
 
     // See if we can support any decode parameters that are specified.
 
-    QPDFObjectHandle decode_obj = this->stream_dict.getKey("/DecodeParms");
+    QPDFObjectHandle decode_obj = m->stream_dict.getKey("/DecodeParms");
     std::vector<QPDFObjectHandle> decode_parms;
     if (decode_obj.isArray() && (decode_obj.getArrayNItems() == 0)) {
         decode_obj = QPDFObjectHandle::newNull();
@@ -541,7 +551,7 @@ QPDF_Stream::pipeStreamData(
             pipeline = new_pipeline.get();
         }
 
-        for (auto iter = this->token_filters.rbegin(); iter != this->token_filters.rend(); ++iter) {
+        for (auto iter = m->token_filters.rbegin(); iter != m->token_filters.rend(); ++iter) {
             new_pipeline =
                 std::make_shared<Pl_QPDFTokenizer>("token filter", (*iter).get(), pipeline);
             to_delete.push_back(new_pipeline);
@@ -560,25 +570,38 @@ QPDF_Stream::pipeStreamData(
         }
     }
 
-    if (this->stream_data.get()) {
+    if (m->stream_data.get()) {
         QTC::TC("qpdf", "QPDF_Stream pipe replaced stream data");
-        pipeline->write(this->stream_data->getBuffer(), this->stream_data->getSize());
-        pipeline->finish();
-    } else if (this->stream_provider.get()) {
+        if (auto* flate = dynamic_cast<Pl_Flate*>(pipeline)) {
+            // The data is all in memory, so it can be inflated or deflated in one step. /DL is
+            // the length of the data after all filters have been removed, so it is only the
+            // length of the inflated data if there is a single filter.
+            auto dl = m->stream_dict.getKey("/DL");
+            size_t decoded_length = 0;
+            if (filter && filters.size() == 1 && dl.isInteger() && dl.getIntValue() > 0) {
+                decoded_length = QIntC::to_size(dl.getIntValue());
+            }
+            flate->writeAll(
+                m->stream_data->getBuffer(), m->stream_data->getSize(), decoded_length);
+        } else {
+            pipeline->write(m->stream_data->getBuffer(), m->stream_data->getSize());
+            pipeline->finish();
+        }
+    } else if (m->stream_provider.get()) {
         Pl_Count count("stream provider count", pipeline);
-        if (this->stream_provider->supportsRetry()) {
-            if (!this->stream_provider->provideStreamData(
-                    og, &count, suppress_warnings, will_retry)) {
+        if (m->stream_provider->supportsRetry()) {
+            if (!m->stream_provider->provideStreamData(
+                    m->obj->getObjGen(), &count, suppress_warnings, will_retry)) {
                 filter = false;
                 success = false;
             }
         } else {
-            this->stream_provider->provideStreamData(og, &count);
+            m->stream_provider->provideStreamData(m->obj->getObjGen(), &count);
         }
         qpdf_offset_t actual_length = count.getCount();
         qpdf_offset_t desired_length = 0;
-        if (success && this->stream_dict.hasKey("/Length")) {
-            desired_length = this->stream_dict.getKey("/Length").getIntValue();
+        if (success && m->stream_dict.hasKey("/Length")) {
+            desired_length = m->stream_dict.getKey("/Length").getIntValue();
             if (actual_length == desired_length) {
                 QTC::TC("qpdf", "QPDF_Stream pipe use stream provider");
             } else {
@@ -586,25 +609,25 @@ QPDF_Stream::pipeStreamData(
                 // This would be caused by programmer error on the part of a library user, not by
                 // invalid input data.
                 throw std::runtime_error(
-                    "stream data provider for " + og.unparse(' ') + " provided " +
+                    "stream data provider for " + m->obj->getObjGen().unparse(' ') + " provided " +
                     std::to_string(actual_length) + " bytes instead of expected " +
                     std::to_string(desired_length) + " bytes");
             }
         } else if (success) {
             QTC::TC("qpdf", "QPDF_Stream provider length not provided");
-            this->stream_dict.replaceKey("/Length", QPDFObjectHandle::newInteger(actual_length));
+            m->stream_dict.replaceKey("/Length", QPDFObjectHandle::newInteger(actual_length));
         }
-    } else if (this->parsed_offset == 0) {
+    } else if (m->obj->getParsedOffset() == 0) {
         QTC::TC("qpdf", "QPDF_Stream pipe no stream data");
         throw std::logic_error("pipeStreamData called for stream with no data");
     } else {
         QTC::TC("qpdf", "QPDF_Stream pipe original stream data");
         if (!QPDF::Pipe::pipeStreamData(
-                this->qpdf,
-                og,
-                this->parsed_offset,
-                this->length,
-                this->stream_dict,
+                m->obj->getQPDF(),
+                m->obj->getObjGen(),
+                m->obj->getParsedOffset(),
+                m->length,
+                m->stream_dict,
                 pipeline,
                 suppress_warnings,
                 will_retry)) {
@@ -635,8 +658,8 @@ QPDF_Stream::replaceStreamData(
     QPDFObjectHandle const& filter,
     QPDFObjectHandle const& decode_parms)
 {
-    this->stream_data = data;
-    this->stream_provider = nullptr;
+    m->stream_data = data;
+    m->stream_provider = nullptr;
     replaceFilterData(filter, decode_parms, data->getSize());
 }
 
@@ -646,15 +669,15 @@ QPDF_Stream::replaceStreamData(
     QPDFObjectHandle const& filter,
     QPDFObjectHandle const& decode_parms)
 {
-    this->stream_provider = provider;
-    this->stream_data = nullptr;
+    m->stream_provider = provider;
+    m->stream_data = nullptr;
     replaceFilterData(filter, decode_parms, 0);
 }
 
 void
 QPDF_Stream::addTokenFilter(std::shared_ptr<QPDFObjectHandle::TokenFilter> token_filter)
 {
-    this->token_filters.push_back(token_filter);
+    m->token_filters.push_back(token_filter);
 }
 
 void
@@ -662,28 +685,29 @@ QPDF_Stream::replaceFilterData(
     QPDFObjectHandle const& filter, QPDFObjectHandle const& decode_parms, size_t length)
 {
     if (filter) {
-        stream_dict.replaceKey("/Filter", filter);
+        m->stream_dict.replaceKey("/Filter", filter);
     }
     if (decode_parms) {
-        stream_dict.replaceKey("/DecodeParms", decode_parms);
+        m->stream_dict.replaceKey("/DecodeParms", decode_parms);
     }
     if (length == 0) {
         QTC::TC("qpdf", "QPDF_Stream unknown stream length");
-        stream_dict.removeKey("/Length");
+        m->stream_dict.removeKey("/Length");
     } else {
-        stream_dict.replaceKey("/Length", QPDFObjectHandle::newInteger(QIntC::to_longlong(length)));
+        m->stream_dict.replaceKey(
+            "/Length", QPDFObjectHandle::newInteger(QIntC::to_longlong(length)));
     }
 }
 
 void
 QPDF_Stream::replaceDict(QPDFObjectHandle const& new_dict)
 {
-    this->stream_dict = new_dict;
+    m->stream_dict = new_dict;
     setDictDescription();
 }
 
 void
 QPDF_Stream::warn(std::string const& message)
 {
-    this->qpdf->warn(qpdf_e_damaged_pdf, "", this->parsed_offset, message);
+    m->obj->getQPDF()->warn(qpdf_e_damaged_pdf, "", m->obj->getParsedOffset(), message);
 }
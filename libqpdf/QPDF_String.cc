@@ -1,6 +1,7 @@
 #include <qpdf/QPDF_String.hh>
 
 #include <qpdf/JSON_writer.hh>
+#include <qpdf/QPDFObject_private.hh>
 #include <qpdf/QUtil.hh>
 
 // DO NOT USE ctype -- it is locale dependent for some things, and it's not worth the risk of
@@ -13,7 +14,6 @@ is_iso_latin1_printable(char ch)
 }
 
 QPDF_String::QPDF_String(std::string const& val) :
-    QPDFValue(::ot_string),
     val(val)
 {
 }
@@ -21,7 +21,7 @@ QPDF_String::QPDF_String(std::string const& val) :
 std::shared_ptr<QPDFObject>
 QPDF_String::create(std::string const& val)
 {
-    return do_create(new QPDF_String(val));
+    return std::make_shared<QPDFObject>(QPDF_String(val));
 }
 
 std::shared_ptr<QPDFObject>
@@ -31,7 +31,7 @@ QPDF_String::create_utf16(std::string const& utf8_val)
     if (!QUtil::utf8_to_pdf_doc(utf8_val, result, '?')) {
         result = QUtil::utf8_to_utf16(utf8_val);
     }
-    return do_create(new QPDF_String(result));
+    return std::make_shared<QPDFObject>(QPDF_String(result));
 }
 
 std::shared_ptr<QPDFObject>
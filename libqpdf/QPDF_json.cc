@@ -6,7 +6,6 @@
 #include <qpdf/Pl_StdioFile.hh>
 #include <qpdf/QIntC.hh>
 #include <qpdf/QPDFObject_private.hh>
-#include <qpdf/QPDFValue.hh>
 #include <qpdf/QPDF_Null.hh>
 #include <qpdf/QPDF_Stream.hh>
 #include <qpdf/QTC.hh>
@@ -226,8 +225,8 @@ class QPDF::JSONReactor: public JSON::Reactor
         pdf(pdf),
         is(is),
         must_be_complete(must_be_complete),
-        descr(std::make_shared<QPDFValue::Description>(
-            QPDFValue::JSON_Descr(std::make_shared<std::string>(is->getName()), "")))
+        descr(std::make_shared<QPDFObject::Description>(
+            QPDFObject::JSON_Descr(std::make_shared<std::string>(is->getName()), "")))
     {
     }
     ~JSONReactor() override = default;
@@ -274,7 +273,7 @@ class QPDF::JSONReactor: public JSON::Reactor
     QPDF& pdf;
     std::shared_ptr<InputSource> is;
     bool must_be_complete{true};
-    std::shared_ptr<QPDFValue::Description> descr;
+    std::shared_ptr<QPDFObject::Description> descr;
     bool errors{false};
     bool saw_qpdf{false};
     bool saw_qpdf_meta{false};
@@ -693,10 +692,10 @@ QPDF::JSONReactor::arrayItem(JSON const& value)
 void
 QPDF::JSONReactor::setObjectDescription(QPDFObjectHandle& oh, JSON const& value)
 {
-    auto j_descr = std::get<QPDFValue::JSON_Descr>(*descr);
+    auto j_descr = std::get<QPDFObject::JSON_Descr>(*descr);
     if (j_descr.object != cur_object) {
-        descr = std::make_shared<QPDFValue::Description>(
-            QPDFValue::JSON_Descr(j_descr.input, cur_object));
+        descr = std::make_shared<QPDFObject::Description>(
+            QPDFObject::JSON_Descr(j_descr.input, cur_object));
     }
 
     oh.getObjectPtr()->setDescription(&pdf, descr, value.getStart());
@@ -528,11 +528,12 @@ QPDF::checkLinearizationInternal()
 qpdf_offset_t
 QPDF::maxEnd(ObjUser const& ou)
 {
-    if (m->obj_user_to_objects.count(ou) == 0) {
+    auto ogs = m->obj_user_map.objects_of(ou);
+    if (ogs.empty()) {
         stopOnError("no entry in object user table for requested object user");
     }
     qpdf_offset_t end = 0;
-    for (auto const& og: m->obj_user_to_objects[ou]) {
+    for (auto const& og: ogs) {
         auto e = m->objects.xref_table().end_after_space(og);
         if (e <= 0) {
             stopOnError("unknown object referenced in object user table");
@@ -972,7 +973,7 @@ QPDF::calculateLinearizationData(T const& object_stream_data)
     // file must be optimized (via calling optimize()) prior to calling this function.  Note that
     // actual offsets and lengths are not computed here, but anything related to object ordering is.
 
-    if (m->object_to_obj_users.empty()) {
+    if (m->obj_user_map.empty()) {
         // Note that we can't call optimize here because we don't know whether it should be called
         // with or without allow changes.
         throw std::logic_error(
@@ -1065,9 +1066,9 @@ QPDF::calculateLinearizationData(T const& object_stream_data)
     std::set<QPDFObjGen> lc_outlines;
     std::set<QPDFObjGen> lc_root;
 
-    for (auto& oiter: m->object_to_obj_users) {
-        QPDFObjGen const& og = oiter.first;
-        std::set<ObjUser>& ous = oiter.second;
+    auto const& map = m->obj_user_map;
+    for (size_t i = 0; i < map.objects().size(); ++i) {
+        QPDFObjGen const& og = map.objects()[i];
 
         bool in_open_document = false;
         bool in_first_page = false;
@@ -1077,7 +1078,8 @@ QPDF::calculateLinearizationData(T const& object_stream_data)
         bool in_outlines = false;
         bool is_root = false;
 
-        for (auto const& ou: ous) {
+        for (auto ou_index: map.users_of(i)) {
+            auto const& ou = map.user(ou_index);
             switch (ou.ou_type) {
             case ObjUser::ou_trailer_key:
                 if (ou.key == "/Encrypt") {
@@ -1247,12 +1249,12 @@ QPDF::calculateLinearizationData(T const& object_stream_data)
 
         m->c_page_offset_data.entries.at(i).nobjects = 1;
 
-        ObjUser ou(ObjUser::ou_page, toI(i));
-        if (m->obj_user_to_objects.count(ou) == 0) {
+        auto ogs = map.objects_of(ObjUser(ObjUser::ou_page, toI(i)));
+        if (ogs.empty()) {
             stopOnError("found unreferenced page while"
                         " calculating linearization data");
         }
-        for (auto const& og: m->obj_user_to_objects[ou]) {
+        for (auto const& og: ogs) {
             if (lc_other_page_private.count(og)) {
                 lc_other_page_private.erase(og);
                 m->part7.push_back(getObject(og));
@@ -1282,8 +1284,7 @@ QPDF::calculateLinearizationData(T const& object_stream_data)
     // we throw all remaining objects in arbitrary order.
 
     // Place the pages tree.
-    std::set<QPDFObjGen> pages_ogs =
-        m->obj_user_to_objects[ObjUser(ObjUser::ou_root_key, "/Pages")];
+    auto pages_ogs = map.objects_of(ObjUser(ObjUser::ou_root_key, "/Pages"));
     if (pages_ogs.empty()) {
         stopOnError("found empty pages tree while"
                     " calculating linearization data");
@@ -1312,8 +1313,7 @@ QPDF::calculateLinearizationData(T const& object_stream_data)
                 // there's nothing to prevent it from having been in some set other than
                 // lc_thumbnail_private.
             }
-            std::set<QPDFObjGen>& ogs = m->obj_user_to_objects[ObjUser(ObjUser::ou_thumb, toI(i))];
-            for (auto const& og: ogs) {
+            for (auto const& og: map.objects_of(ObjUser(ObjUser::ou_thumb, toI(i)))) {
                 if (lc_thumbnail_private.count(og)) {
                     lc_thumbnail_private.erase(og);
                     m->part9.push_back(getObject(og));
@@ -1345,7 +1345,7 @@ QPDF::calculateLinearizationData(T const& object_stream_data)
 
     size_t num_placed =
         m->part4.size() + m->part6.size() + m->part7.size() + m->part8.size() + m->part9.size();
-    size_t num_wanted = m->object_to_obj_users.size();
+    size_t num_wanted = map.objects().size();
     if (num_placed != num_wanted) {
         stopOnError(
             "INTERNAL ERROR: QPDF::calculateLinearizationData: wrong "
@@ -1392,13 +1392,13 @@ QPDF::calculateLinearizationData(T const& object_stream_data)
 
     for (size_t i = 1; i < toS(npages); ++i) {
         CHPageOffsetEntry& pe = m->c_page_offset_data.entries.at(i);
-        ObjUser ou(ObjUser::ou_page, toI(i));
-        if (m->obj_user_to_objects.count(ou) == 0) {
+        auto ogs = map.objects_of(ObjUser(ObjUser::ou_page, toI(i)));
+        if (ogs.empty()) {
             stopOnError("found unreferenced page while"
                         " calculating linearization data");
         }
-        for (auto const& og: m->obj_user_to_objects[ou]) {
-            if ((m->object_to_obj_users[og].size() > 1) && (obj_to_index.count(og.getObj()) > 0)) {
+        for (auto const& og: ogs) {
+            if ((map.user_count(og) > 1) && (obj_to_index.count(og.getObj()) > 0)) {
                 int idx = obj_to_index[og.getObj()];
                 ++pe.nshared_objects;
                 pe.shared_identifiers.push_back(idx);
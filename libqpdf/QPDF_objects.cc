@@ -2,15 +2,21 @@
 
 #include <qpdf/QPDF_private.hh>
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <limits>
 #include <map>
+#include <optional>
 #include <vector>
 
+#include <qpdf/Buffer.hh>
 #include <qpdf/BufferInputSource.hh>
 #include <qpdf/OffsetInputSource.hh>
 #include <qpdf/Pipeline.hh>
+#include <qpdf/Pl_Buffer.hh>
+#include <qpdf/Pl_Flate.hh>
+#include <qpdf/Pl_String.hh>
 #include <qpdf/QPDFExc.hh>
 #include <qpdf/QPDFLogger.hh>
 #include <qpdf/QPDFObject_private.hh>
@@ -23,6 +29,7 @@
 #include <qpdf/QPDF_Unresolved.hh>
 #include <qpdf/QTC.hh>
 #include <qpdf/QUtil.hh>
+#include <qpdf/WorkerPool.hh>
 
 using Objects = QPDF::Objects;
 using Xref_table = Objects::Xref_table;
@@ -200,6 +207,8 @@ Xref_table::reconstruct(QPDFExc& e)
             iter = {};
         }
     }
+    ends.clear();
+    large_ends.clear();
 
     std::vector<std::tuple<int, int, qpdf_offset_t>> found_objects;
     std::vector<qpdf_offset_t> trailers;
@@ -207,32 +216,23 @@ Xref_table::reconstruct(QPDFExc& e)
 
     file->seek(0, SEEK_END);
     qpdf_offset_t eof = file->tell();
-    file->seek(0, SEEK_SET);
-    // Don't allow very long tokens here during recovery. All the interesting tokens are covered.
-    static size_t const MAX_LEN = 10;
-    while (file->tell() < eof) {
-        QPDFTokenizer::Token t1 = read_token(MAX_LEN);
-        qpdf_offset_t token_start = file->tell() - toO(t1.getValue().length());
-        if (t1.isInteger()) {
-            auto pos = file->tell();
-            QPDFTokenizer::Token t2 = read_token(MAX_LEN);
-            if (t2.isInteger() && read_token(MAX_LEN).isWord("obj")) {
-                int obj = QUtil::string_to_int(t1.getValue().c_str());
-                int gen = QUtil::string_to_int(t2.getValue().c_str());
-                if (obj <= max_id_) {
-                    found_objects.emplace_back(obj, gen, token_start);
-                    if (obj > max_found) {
-                        max_found = obj;
-                    }
-                } else {
-                    warn_damaged("ignoring object with impossibly large id " + std::to_string(obj));
-                }
+    Scan result;
+    if (qpdf.m->recovery_threads > 1) {
+        scan_parallel(eof, toS(qpdf.m->recovery_threads), result);
+    } else {
+        scan(*file, tokenizer, 0, eof, !trailer_, result);
+    }
+    for (auto const& found: result.found) {
+        if (found.trailer) {
+            trailers.emplace_back(found.offset);
+        } else if (found.obj <= max_id_) {
+            found_objects.emplace_back(found.obj, found.gen, found.offset);
+            if (found.obj > max_found) {
+                max_found = found.obj;
             }
-            file->seek(pos, SEEK_SET);
-        } else if (!trailer_ && t1.isWord("trailer")) {
-            trailers.emplace_back(file->tell());
+        } else {
+            warn_damaged("ignoring object with impossibly large id " + std::to_string(found.obj));
         }
-        file->findAndSkipNextEOL();
     }
 
     table.resize(toS(max_found) + 1);
@@ -320,6 +320,119 @@ Xref_table::reconstruct(QPDFExc& e)
     // It's safe to call it more than once.
 }
 
+void
+Xref_table::scan(
+    InputSource& input,
+    QPDFTokenizer& tokenizer,
+    qpdf_offset_t start,
+    qpdf_offset_t end,
+    bool find_trailers,
+    Scan& result)
+{
+    // Look at the first token of each line starting before end for "n g obj" and "trailer". This
+    // must only use the arguments as it may be called on several threads at once.
+    // Don't allow very long tokens here during recovery. All the interesting tokens are covered.
+    static size_t const MAX_LEN = 10;
+    input.seek(start, SEEK_SET);
+    while (input.tell() < end) {
+        auto line = input.tell();
+        if (result.lines.size() < result.max_lines) {
+            result.lines.emplace_back(line);
+        }
+        QPDFTokenizer::Token t1 = tokenizer.readToken(input, "", true, MAX_LEN);
+        qpdf_offset_t token_start = input.tell() - toO(t1.getValue().length());
+        if (t1.isInteger()) {
+            auto pos = input.tell();
+            QPDFTokenizer::Token t2 = tokenizer.readToken(input, "", true, MAX_LEN);
+            if (t2.isInteger() && tokenizer.readToken(input, "", true, MAX_LEN).isWord("obj")) {
+                result.found.push_back(
+                    {line,
+                     false,
+                     QUtil::string_to_int(t1.getValue().c_str()),
+                     QUtil::string_to_int(t2.getValue().c_str()),
+                     token_start});
+            }
+            input.seek(pos, SEEK_SET);
+        } else if (find_trailers && t1.isWord("trailer")) {
+            result.found.push_back({line, true, 0, 0, input.tell()});
+        }
+        input.findAndSkipNextEOL();
+    }
+    result.end = input.tell();
+}
+
+void
+Xref_table::scan_parallel(qpdf_offset_t eof, size_t n_threads, Scan& result)
+{
+    // Scan the file in chunks on a pool of threads, and then join the results together. Where a
+    // scan begins depends on where the scan of the previous line ended, so the scan of each chunk
+    // after the first starts at an arbitrary point and its results are only used from the first
+    // line that the scan of the preceding part of the file also visits. From that point on, both
+    // scans are identical. This is almost always within a line or two of the start of the chunk.
+    // Otherwise, the preceding scan is continued through the chunk on this thread. The result is
+    // exactly the same as that of a single scan of the whole file. This is only possible when the
+    // contents of the input source are directly accessible from memory, as they need to be read by
+    // several threads at once.
+    char const* data = nullptr;
+    size_t size = 0;
+    qpdf_offset_t const min_chunk_size = 1 << 20;
+    auto chunk_size = std::max(eof / toO(4 * n_threads), min_chunk_size);
+    if (!file->getContiguousData(data, size) || toO(size) != eof || eof <= chunk_size) {
+        scan(*file, tokenizer, 0, eof, !trailer_, result);
+        return;
+    }
+
+    bool find_trailers = !trailer_;
+    std::vector<Scan> chunks(toS((eof + chunk_size - 1) / chunk_size));
+    Buffer buffer(reinterpret_cast<unsigned char*>(const_cast<char*>(data)), size);
+    {
+        WorkerPool pool(n_threads);
+        std::vector<std::future<void>> done;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            done.emplace_back(pool.submit([&buffer, &chunks, i, chunk_size, eof, find_trailers]() {
+                BufferInputSource input("", &buffer);
+                QPDFTokenizer tokenizer;
+                tokenizer.allowEOF();
+                auto& chunk = chunks[i];
+                chunk.max_lines = 64;
+                scan(
+                    input,
+                    tokenizer,
+                    toO(i) * chunk_size,
+                    std::min(toO(i + 1) * chunk_size, eof),
+                    find_trailers,
+                    chunk);
+            }));
+        }
+        for (auto& d: done) {
+            d.get();
+        }
+    }
+
+    qpdf_offset_t next = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto& chunk = chunks[i];
+        auto chunk_end = std::min(toO(i + 1) * chunk_size, eof);
+        while (next < chunk_end) {
+            if (std::binary_search(chunk.lines.begin(), chunk.lines.end(), next)) {
+                auto from = std::find_if(chunk.found.begin(), chunk.found.end(), [next](auto& f) {
+                    return f.line >= next;
+                });
+                result.found.insert(result.found.end(), from, chunk.found.end());
+                next = chunk.end;
+            } else if (chunk.lines.empty() || next > chunk.lines.back()) {
+                scan(*file, tokenizer, next, chunk_end, find_trailers, result);
+                next = result.end;
+            } else {
+                // Scan one line and try again.
+                scan(*file, tokenizer, next, next + 1, find_trailers, result);
+                next = result.end;
+            }
+        }
+    }
+    result.end = next;
+}
+
 void
 Xref_table::read(qpdf_offset_t xref_offset)
 {
@@ -1026,11 +1139,11 @@ Xref_table::insert(int obj, int f0, qpdf_offset_t f1, int f2)
     case 1:
         // f2 is generation
         QTC::TC("qpdf", "QPDF xref gen > 0", (f2 > 0) ? 1 : 0);
-        entry = {f2, Uncompressed(f1)};
+        entry = Entry::uncompressed(f2, f1);
         break;
 
     case 2:
-        entry = {0, Compressed(toI(f1), f2)};
+        entry = Entry::compressed(toI(f1), f2);
         object_streams_ = true;
         break;
 
@@ -1039,6 +1152,7 @@ Xref_table::insert(int obj, int f0, qpdf_offset_t f1, int f2)
             "xref stream", "unknown xref stream entry type " + std::to_string(f0));
         break;
     }
+    reset_ends(static_cast<size_t>(obj));
 }
 
 void
@@ -1052,7 +1166,8 @@ Xref_table::insert_free(QPDFObjGen og)
     }
     size_t id = static_cast<size_t>(og.getObj());
     if (id < table.size() && !type(id)) {
-        table[id] = {1, {}};
+        table[id] = Entry::free(1);
+        reset_ends(id);
     }
 }
 
@@ -1076,28 +1191,68 @@ Xref_table::at_offset(qpdf_offset_t offset) const noexcept
     return QPDFObjGen(id, gen);
 }
 
+Xref_table::const_iterator::value_type
+Xref_table::const_iterator::operator*() const
+{
+    auto const& item = xref->table[id];
+    QPDFObjGen og(toI(id), item.gen());
+    switch (item.type()) {
+    case 1:
+        return {og, item.offset()};
+    case 2:
+        return {og, QPDFXRefEntry(item.stream_number(), item.stream_index())};
+    default:
+        throw std::logic_error("Xref_table: invalid entry type");
+    }
+}
+
 std::map<QPDFObjGen, QPDFXRefEntry>
 Xref_table::as_map() const
 {
-    std::map<QPDFObjGen, QPDFXRefEntry> result;
-    int i{0};
-    for (auto const& item: table) {
-        switch (item.type()) {
-        case 0:
-            break;
-        case 1:
-            result.emplace(QPDFObjGen(i, item.gen()), item.offset());
-            break;
-        case 2:
-            result.emplace(
-                QPDFObjGen(i, 0), QPDFXRefEntry(item.stream_number(), item.stream_index()));
-            break;
-        default:
-            throw std::logic_error("Xref_table: invalid entry type");
+    return {begin(), end()};
+}
+
+void
+Xref_table::linearization_offsets(size_t id, qpdf_offset_t before, qpdf_offset_t after)
+{
+    // Only the ends of uncompressed objects are ever looked up. They almost always follow the
+    // offset closely enough to be stored as 32-bit distances.
+    if (type(id) != 1) {
+        return;
+    }
+    reset_ends(id);
+    auto offset = table[id].offset();
+    auto max = static_cast<qpdf_offset_t>(std::numeric_limits<uint32_t>::max());
+    if (offset < before && before <= after && after - offset <= max) {
+        if (id >= ends.size()) {
+            ends.resize(id + 1);
         }
-        ++i;
+        ends[id] = {static_cast<uint32_t>(before - offset), static_cast<uint32_t>(after - offset)};
+    } else {
+        large_ends[id] = {before, after};
     }
-    return result;
+}
+
+qpdf_offset_t
+Xref_table::object_end(QPDFObjGen og, bool after_space) const
+{
+    auto id = toS(og.getObj());
+    auto t = type(id);
+    if (t == 2) {
+        id = toS(table[id].stream_number());
+        t = type(id);
+    }
+    if (t != 1) {
+        return 0;
+    }
+    if (id < ends.size() && ends[id].before) {
+        auto const& e = ends[id];
+        return table[id].offset() + (after_space ? e.after : e.before);
+    }
+    if (auto it = large_ends.find(id); it != large_ends.end()) {
+        return after_space ? it->second.second : it->second.first;
+    }
+    return 0;
 }
 
 void
@@ -1143,8 +1298,12 @@ Xref_table::resolve()
                     return false;
                 }
             }
+            // When called while QPDFWriter is releasing objects, only check that the object can
+            // be read.
+            objects.release(QPDFObjGen(i, item.gen()));
         }
     }
+    objects.reset_released();
     return true;
 }
 
@@ -1187,9 +1346,20 @@ Objects::read_object(std::string const& description, QPDFObjGen og)
 
     StringDecrypter decrypter{&qpdf, og};
     StringDecrypter* decrypter_ptr = m->encp->encrypted ? &decrypter : nullptr;
-    auto object =
-        QPDFParser(*m->file, m->last_object_description, m->tokenizer, decrypter_ptr, &qpdf, true)
-            .parse(empty, false);
+    std::shared_ptr<QPDF::DeferredInput> deferred_input;
+    if (m->lazy_parsing) {
+        deferred_input = std::make_shared<QPDF::DeferredInput>(
+            qpdf, nullptr, "", og, m->last_object_description);
+    }
+    auto object = QPDFParser(
+                      *m->file,
+                      m->last_object_description,
+                      m->tokenizer,
+                      decrypter_ptr,
+                      &qpdf,
+                      true,
+                      deferred_input)
+                      .parse(empty, false);
     if (empty) {
         // Nothing in the PDF spec appears to allow empty objects, but they have been encountered in
         // actual PDF files and Adobe Reader appears to ignore them.
@@ -1303,15 +1473,23 @@ Objects::validate_stream_line_end(QPDFObjectHandle& object, QPDFObjGen og, qpdf_
 }
 
 QPDFObjectHandle
-Objects::readObjectInStream(std::shared_ptr<InputSource>& input, int obj)
+Objects::readObjectInStream(
+    std::shared_ptr<InputSource>& input, std::shared_ptr<Buffer> const& data, int obj)
 {
     m->last_object_description.erase(7); // last_object_description starts with "object "
     m->last_object_description += std::to_string(obj);
     m->last_object_description += " 0";
 
     bool empty = false;
-    auto object = QPDFParser(*input, m->last_object_description, m->tokenizer, nullptr, &qpdf, true)
-                      .parse(empty, false);
+    std::shared_ptr<QPDF::DeferredInput> deferred_input;
+    if (m->lazy_parsing) {
+        deferred_input = std::make_shared<QPDF::DeferredInput>(
+            qpdf, data, input->getName(), QPDFObjGen(obj, 0), m->last_object_description);
+    }
+    auto object =
+        QPDFParser(
+            *input, m->last_object_description, m->tokenizer, nullptr, &qpdf, true, deferred_input)
+            .parse(empty, false);
     if (empty) {
         // Nothing in the PDF spec appears to allow empty objects, but they have been encountered in
         // actual PDF files and Adobe Reader appears to ignore them.
@@ -1551,6 +1729,19 @@ Objects::resolve(QPDFObjGen og)
         return table[og].object.get();
     }
     ResolveRecorder rr(&qpdf, og);
+    struct MuteWarnings
+    {
+        ~MuteWarnings()
+        {
+            flag = saved;
+        }
+        bool& flag;
+        bool saved;
+    } mute{m->mute_warnings, m->mute_warnings};
+    if (toS(og.getObj()) < was_released.size() && was_released[toS(og.getObj())]) {
+        QTC::TC("qpdf", "QPDF read released object");
+        m->mute_warnings = true;
+    }
 
     try {
         switch (xref.type(og)) {
@@ -1565,6 +1756,15 @@ Objects::resolve(QPDFObjGen og)
             break;
 
         case 2:
+            if (!released.empty()) {
+                // The object stream may have been read before without this object if it had been
+                // released. If the xref table was reconstructed while writing, the id may be past
+                // the end of released.
+                if (toS(og.getObj()) < released.size()) {
+                    released[toS(og.getObj())] = false;
+                }
+                m->resolved_object_streams.erase(xref.stream_number(og.getObj()));
+            }
             resolveObjectsInStream(xref.stream_number(og.getObj()));
             break;
 
@@ -1590,6 +1790,50 @@ Objects::resolve(QPDFObjGen og)
     return result.get();
 }
 
+std::shared_ptr<QPDFObject>
+QPDF::Resolver::parsed(QPDF_Deferred const& deferred)
+{
+    auto m = deferred.input->m.lock();
+    return m ? m->objects.parse_deferred(deferred) : nullptr;
+}
+
+std::shared_ptr<QPDFObject>
+Objects::parse_deferred(QPDF_Deferred const& deferred)
+{
+    auto const& in = *deferred.input;
+    auto input = in.data ? std::make_shared<BufferInputSource>(in.input_name, in.data.get())
+                         : m->file_sp;
+    // Parsing may happen while the input is being read for some other purpose.
+    auto position = input->tell();
+    auto last_offset = input->getLastOffset();
+    input->seek(deferred.offset, SEEK_SET);
+
+    std::shared_ptr<QPDFObject> result;
+    std::optional<QPDFExc> error;
+    try {
+        QTC::TC("qpdf", "QPDF parse deferred", in.data ? 1 : 0);
+        QPDFTokenizer tokenizer;
+        StringDecrypter decrypter{&qpdf, in.og};
+        StringDecrypter* decrypter_ptr = !in.data && m->encp->encrypted ? &decrypter : nullptr;
+        bool empty = false;
+        result = QPDFParser(
+                     *input, in.description, tokenizer, decrypter_ptr, &qpdf, true, deferred.input)
+                     .parse(empty, false)
+                     .getObj();
+    } catch (QPDFExc& e) {
+        error = e;
+    } catch (std::exception& e) {
+        error = damagedPDF(*input, in.description, deferred.offset, e.what());
+    }
+    input->seek(position, SEEK_SET);
+    input->setLastOffset(last_offset);
+    if (error) {
+        qpdf.warn(*error);
+        return QPDF_Null::create();
+    }
+    return result;
+}
+
 void
 Objects::resolveObjectsInStream(int obj_stream_number)
 {
@@ -1621,7 +1865,14 @@ Objects::resolveObjectsInStream(int obj_stream_number)
 
     std::map<int, int> offsets;
 
-    std::shared_ptr<Buffer> bp = obj_stream.getStreamData(qpdf_dl_specialized);
+    std::shared_ptr<Buffer> bp;
+    auto preloaded_data = preloaded.find(obj_stream_number);
+    if (preloaded_data != preloaded.end()) {
+        bp = std::move(preloaded_data->second);
+        preloaded.erase(preloaded_data);
+    } else {
+        bp = obj_stream.getStreamData(qpdf_dl_specialized);
+    }
     auto input = std::shared_ptr<InputSource>(
         // line-break
         new BufferInputSource(
@@ -1675,9 +1926,17 @@ Objects::resolveObjectsInStream(int obj_stream_number)
     for (auto const& iter: offsets) {
         QPDFObjGen og(iter.first, 0);
         if (xref.type(og) == 2 && xref.stream_number(og.getObj()) == obj_stream_number) {
+            if (!released.empty() &&
+                ((toS(iter.first) < released.size() && released[toS(iter.first)]) ||
+                 !unresolved(og))) {
+                // Don't read objects again that QPDFWriter has released, and don't replace objects
+                // that have been resolved while other objects from this stream were released.
+                QTC::TC("qpdf", "QPDF skip released objstm object");
+                continue;
+            }
             int offset = iter.second;
             input->seek(offset, SEEK_SET);
-            QPDFObjectHandle oh = readObjectInStream(input, iter.first);
+            QPDFObjectHandle oh = readObjectInStream(input, bp, iter.first);
             update_table(og, oh.getObj());
         } else {
             QTC::TC("qpdf", "QPDF not caching overridden objstm object");
@@ -1685,6 +1944,99 @@ Objects::resolveObjectsInStream(int obj_stream_number)
     }
 }
 
+void
+Objects::preload_object_streams(size_t n_threads)
+{
+    // Only inflating the stream data is done by the worker threads. Reading the raw data and
+    // parsing the objects use the input source and the object table, which are not thread-safe.
+    // Streams that can't be inflated here without any warnings are left for resolveObjectsInStream
+    // to decode in the usual way so that any problems are reported exactly as they would be
+    // otherwise. Streams are handled in batches to limit the amount of data held in memory.
+    struct Job
+    {
+        QPDFObjGen first_object;
+        std::string raw;
+        std::shared_ptr<Buffer> data;
+        std::future<void> done;
+    };
+
+    // Object streams, in order, with the first object that is to be loaded from each.
+    std::map<int, int> streams;
+    for (auto const& [id, stream_number]: xref.compressed_objects()) {
+        if (!m->resolved_object_streams.count(stream_number)) {
+            streams.emplace(stream_number, toI(id));
+        }
+    }
+
+    // The pool must be destroyed before the jobs its tasks refer to.
+    std::vector<Job> jobs;
+    WorkerPool pool(n_threads);
+    size_t const batch_size = 4 * pool.size();
+    jobs.reserve(batch_size);
+    auto iter = streams.begin();
+    while (iter != streams.end()) {
+        jobs.clear();
+        for (; iter != streams.end() && jobs.size() < batch_size; ++iter) {
+            auto& job = jobs.emplace_back();
+            job.first_object = QPDFObjGen(iter->second, 0);
+            auto obj_stream = get(iter->first, 0);
+            if (!obj_stream.isStream()) {
+                continue;
+            }
+            auto dict = obj_stream.getDict();
+            auto filter = dict.getKey("/Filter");
+            if (filter.isArray() && filter.getArrayNItems() == 1) {
+                filter = filter.getArrayItem(0);
+            }
+            qpdf_offset_t offset = 0;
+            size_t length = 0;
+            if (!((filter.isNameAndEquals("/FlateDecode") || filter.isNameAndEquals("/Fl")) &&
+                  dict.getKey("/DecodeParms").isNull() &&
+                  qpdf.getRawStreamDataRange(obj_stream, offset, length))) {
+                continue;
+            }
+            Pl_String raw("object stream raw data", nullptr, job.raw);
+            pipeRawStreamData(*m->file, offset, length, &raw);
+            auto dl = dict.getKey("/DL");
+            size_t decoded_length =
+                dl.isInteger() && dl.getIntValue() > 0 ? toS(dl.getIntValue()) : 0;
+            job.done = pool.submit([&job, decoded_length]() {
+                bool warned = false;
+                Pl_Buffer buffer("object stream data");
+                Pl_Flate inflate("object stream inflate", &buffer, Pl_Flate::a_inflate);
+                inflate.setWarnCallback([&warned](char const*, int) { warned = true; });
+                inflate.writeAll(
+                    reinterpret_cast<unsigned char const*>(job.raw.data()),
+                    job.raw.size(),
+                    decoded_length);
+                if (!warned) {
+                    job.data = buffer.getBufferSharedPointer();
+                }
+            });
+        }
+        for (auto& job: jobs) {
+            if (job.done.valid()) {
+                try {
+                    job.done.get();
+                } catch (std::exception&) {
+                    // Leave the stream to be decoded and reported by resolveObjectsInStream.
+                }
+            }
+        }
+        for (auto& job: jobs) {
+            int stream_number = xref.stream_number(job.first_object.getObj());
+            if (job.data) {
+                QTC::TC("qpdf", "QPDF preload object stream");
+                preloaded[stream_number] = job.data;
+            }
+            // Resolving an object in the stream loads all of its objects, and reports any errors
+            // in the same way as accessing the object would.
+            resolve(job.first_object);
+            preloaded.erase(stream_number);
+        }
+    }
+}
+
 Objects::~Objects()
 {
     // If two objects are mutually referential (through each object having an array or dictionary
@@ -1711,7 +2063,7 @@ Objects::update_table(QPDFObjGen og, const std::shared_ptr<QPDFObject>& object)
     object->setObjGen(&qpdf, og);
     if (cached(og)) {
         auto& cache = table[og];
-        cache.object->assign(object);
+        object->move_to(cache.object);
     } else {
         table[og] = Entry(object);
     }
@@ -1758,7 +2110,12 @@ Objects::get_for_parser(int id, int gen, bool parse_pdf)
     // This method is called by the parser and therefore must not resolve any objects.
     auto og = QPDFObjGen(id, gen);
     if (auto iter = table.find(og); iter != table.end()) {
-        return iter->second.object;
+        if (!(parse_pdf && !releasable.empty() && id >= first_new_id)) {
+            return iter->second.object;
+        }
+        // Objects that QPDFWriter has released must not refer to objects that have been created
+        // since they were first read.
+        QTC::TC("qpdf", "QPDF ignore new object when reading released object");
     }
     if (xref.type(og) || !xref.initialized()) {
         return table.insert({og, QPDF_Unresolved::create(&qpdf, og)}).first->second.object;
@@ -1789,7 +2146,14 @@ Objects::replace(QPDFObjGen og, QPDFObjectHandle oh)
         QTC::TC("qpdf", "QPDF replaceObject called with indirect object");
         throw std::logic_error("QPDF::replaceObject called with indirect object handle");
     }
-    update_table(og, oh.getObj());
+    // Rather than moving the value of oh into the table as update_table does, make the table entry
+    // refer to oh. This keeps the value with oh if og is replaced again or the QPDF is destroyed.
+    auto const& object = oh.getObj();
+    object->setObjGen(&qpdf, og);
+    if (!cached(og)) {
+        table[og] = Entry(QPDF_Null::create(&qpdf, og));
+    }
+    table[og].object->refer_to(object);
 }
 
 void
@@ -1797,8 +2161,7 @@ Objects::erase(QPDFObjGen og)
 {
     if (auto cached = table.find(og); cached != table.end()) {
         // Take care of any object handles that may be floating around.
-        cached->second.object->assign(QPDF_Null::create());
-        cached->second.object->setObjGen(nullptr, QPDFObjGen());
+        cached->second.object->assign_null();
         table.erase(cached);
     }
 }
@@ -1835,6 +2198,73 @@ Objects::table_size()
     return toS(++max_xref);
 }
 
+void
+Objects::start_release()
+{
+    releasable.assign(xref.size(), false);
+    released.assign(releasable.size(), false);
+    was_released.assign(releasable.size(), false);
+    first_new_id = table.empty() ? 1 : table.rbegin()->first.getObj() + 1;
+    first_new_id = std::max(first_new_id, toI(xref.size()));
+    for (size_t id = 1; id < releasable.size(); ++id) {
+        if (xref.type(id)) {
+            releasable[id] = unresolved(QPDFObjGen(toI(id), xref.gen(id)));
+        }
+    }
+}
+
+void
+Objects::release(QPDFObjGen og)
+{
+    auto id = toS(og.getObj());
+    if (id >= releasable.size() || !releasable[id] || !xref.type(og)) {
+        return;
+    }
+    if (auto it = table.find(og); it != table.end() && !it->second.object->isUnresolved()) {
+        it->second.object->assign_unresolved();
+        released[id] = true;
+        was_released[id] = true;
+    }
+}
+
+bool
+Objects::is_stream(QPDFObjectHandle& oh)
+{
+    // While objects are being released, don't keep objects in memory that are only read to answer
+    // this question. Objects in object streams can't be streams, and other objects are released
+    // again once they have been read.
+    auto og = oh.getObjGen();
+    auto id = toS(og.getObj());
+    if (id < releasable.size() && releasable[id] && unresolved(og)) {
+        if (xref.type(og) == 2) {
+            return false;
+        }
+        bool result = oh.isStream();
+        release(og);
+        return result;
+    }
+    return oh.isStream();
+}
+
+void
+Objects::reset_released()
+{
+    // This is called after a pass over all objects that released them as it went. The objects are
+    // about to be read again, so let them be read together with the other objects in their object
+    // streams.
+    if (!released.empty()) {
+        released.assign(released.size(), false);
+    }
+}
+
+void
+Objects::stop_release()
+{
+    releasable.clear();
+    released.clear();
+    was_released.clear();
+}
+
 std::vector<QPDFObjGen>
 Objects::compressible_vector()
 {
@@ -1938,7 +2368,11 @@ Objects::compressible()
                 queue.push_back(obj.getArrayItem(n - i));
             }
         }
+        if (!releasable.empty() && obj.isIndirect()) {
+            release(obj.getObjGen());
+        }
     }
+    reset_released();
 
     return result;
 }
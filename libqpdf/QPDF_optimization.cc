@@ -10,6 +10,8 @@
 #include <qpdf/QPDF_Dictionary.hh>
 #include <qpdf/QTC.hh>
 
+#include <algorithm>
+
 QPDF::ObjUser::ObjUser() :
     ou_type(ou_bad),
     pageno(0)
@@ -54,8 +56,80 @@ QPDF::ObjUser::operator<(ObjUser const& rhs) const
     return false;
 }
 
-QPDF::UpdateObjectMapsFrame::UpdateObjectMapsFrame(
-    QPDF::ObjUser const& ou, QPDFObjectHandle oh, bool top) :
+size_t
+QPDF::ObjUserMap::add_user(ObjUser const& ou)
+{
+    auto [it, inserted] = user_index.emplace(ou, users.size());
+    if (inserted) {
+        users.emplace_back(ou);
+    }
+    return it->second;
+}
+
+void
+QPDF::ObjUserMap::finish()
+{
+    std::sort(uses.begin(), uses.end());
+    uses.erase(std::unique(uses.begin(), uses.end()), uses.end());
+
+    user_start.assign(users.size() + 1, 0);
+    user_objects.clear();
+    user_objects.reserve(uses.size());
+    for (auto const& [user, og]: uses) {
+        ++user_start[user + 1];
+        user_objects.emplace_back(og);
+    }
+    for (size_t i = 0; i < users.size(); ++i) {
+        user_start[i + 1] += user_start[i];
+    }
+
+    // Sort the uses by object to list the users of each object.
+    std::sort(uses.begin(), uses.end(), [](auto const& a, auto const& b) {
+        return a.second < b.second || (a.second == b.second && a.first < b.first);
+    });
+    objects_.clear();
+    object_start.clear();
+    object_users.clear();
+    object_users.reserve(uses.size());
+    for (auto const& [user, og]: uses) {
+        if (objects_.empty() || objects_.back() != og) {
+            objects_.emplace_back(og);
+            object_start.emplace_back(object_users.size());
+        }
+        object_users.emplace_back(user);
+    }
+    object_start.emplace_back(object_users.size());
+
+    uses.clear();
+    uses.shrink_to_fit();
+    visited.clear();
+    visited.shrink_to_fit();
+    visited_other.clear();
+}
+
+QPDF::ObjUserMap::Range<QPDFObjGen>
+QPDF::ObjUserMap::objects_of(ObjUser const& ou) const
+{
+    auto it = user_index.find(ou);
+    if (it == user_index.end() || it->second + 1 >= user_start.size()) {
+        return {nullptr, nullptr};
+    }
+    auto data = user_objects.data();
+    return {data + user_start[it->second], data + user_start[it->second + 1]};
+}
+
+size_t
+QPDF::ObjUserMap::user_count(QPDFObjGen og) const
+{
+    auto it = std::lower_bound(objects_.begin(), objects_.end(), og);
+    if (it == objects_.end() || *it != og) {
+        return 0;
+    }
+    auto i = static_cast<size_t>(it - objects_.begin());
+    return object_start[i + 1] - object_start[i];
+}
+
+QPDF::UpdateObjectMapsFrame::UpdateObjectMapsFrame(size_t ou, QPDFObjectHandle oh, bool top) :
     ou(ou),
     oh(oh),
     top(top)
@@ -91,7 +165,7 @@ QPDF::optimize_internal(
     bool allow_changes,
     std::function<int(QPDFObjectHandle&)> skip_stream_parameters)
 {
-    if (!m->obj_user_to_objects.empty()) {
+    if (!m->obj_user_map.empty()) {
         // already optimized
         return;
     }
@@ -141,12 +215,10 @@ QPDF::optimize_internal(
             ObjUser(ObjUser::ou_root_key, key), root.getKey(key), skip_stream_parameters);
     }
 
-    ObjUser root_ou = ObjUser(ObjUser::ou_root);
-    auto root_og = QPDFObjGen(root.getObjGen());
-    m->obj_user_to_objects[root_ou].insert(root_og);
-    m->object_to_obj_users[root_og].insert(root_ou);
+    m->obj_user_map.add(m->obj_user_map.add_user(ObjUser(ObjUser::ou_root)), root.getObjGen());
 
     filterCompressedObjects(object_stream_data);
+    m->obj_user_map.finish();
 }
 
 void
@@ -295,11 +367,11 @@ QPDF::updateObjectMaps(
     QPDFObjectHandle first_oh,
     std::function<int(QPDFObjectHandle&)> skip_stream_parameters)
 {
-    QPDFObjGen::set visited;
+    auto& map = m->obj_user_map;
+    map.start_traversal();
     std::vector<UpdateObjectMapsFrame> pending;
-    pending.emplace_back(first_ou, first_oh, true);
+    pending.emplace_back(map.add_user(first_ou), first_oh, true);
     // Traverse the object tree from this point taking care to avoid crossing page boundaries.
-    std::unique_ptr<ObjUser> thumb_ou;
     while (!pending.empty()) {
         auto cur = pending.back();
         pending.pop_back();
@@ -315,18 +387,16 @@ QPDF::updateObjectMaps(
 
         if (cur.oh.isIndirect()) {
             QPDFObjGen og(cur.oh.getObjGen());
-            if (!visited.add(og)) {
+            if (!map.visit(og)) {
                 QTC::TC("qpdf", "QPDF opt loop detected");
                 continue;
             }
-            m->obj_user_to_objects[cur.ou].insert(og);
-            m->object_to_obj_users[og].insert(cur.ou);
+            map.add(cur.ou, og);
         }
 
         if (cur.oh.isArray()) {
-            int n = cur.oh.getArrayNItems();
-            for (int i = 0; i < n; ++i) {
-                pending.emplace_back(cur.ou, cur.oh.getArrayItem(i), false);
+            for (auto& item: cur.oh.getArrayAsVector()) {
+                pending.emplace_back(cur.ou, std::move(item), false);
             }
         } else if (cur.oh.isDictionary() || cur.oh.isStream()) {
             QPDFObjectHandle dict = cur.oh;
@@ -339,12 +409,14 @@ QPDF::updateObjectMaps(
                 }
             }
 
-            for (auto const& key: dict.getKeys()) {
-                if (is_page_node && (key == "/Thumb")) {
+            for (auto& [key, value]: dict.getDictAsMap()) {
+                if (value.isNull()) {
+                    // Keys with null values are treated as absent.
+                } else if (is_page_node && (key == "/Thumb")) {
                     // Traverse page thumbnail dictionaries as a special case. There can only ever
                     // be one /Thumb key on a page, and we see at most one page node per call.
-                    thumb_ou = std::make_unique<ObjUser>(ObjUser::ou_thumb, cur.ou.pageno);
-                    pending.emplace_back(*thumb_ou, dict.getKey(key), false);
+                    auto thumb_ou = map.add_user(ObjUser(ObjUser::ou_thumb, first_ou.pageno));
+                    pending.emplace_back(thumb_ou, std::move(value), false);
                 } else if (is_page_node && (key == "/Parent")) {
                     // Don't traverse back up the page tree
                 } else if (
@@ -352,7 +424,7 @@ QPDF::updateObjectMaps(
                     ((ssp >= 2) && ((key == "/Filter") || (key == "/DecodeParms")))) {
                     // Don't traverse into stream parameters that we are not going to write.
                 } else {
-                    pending.emplace_back(cur.ou, dict.getKey(key), false);
+                    pending.emplace_back(cur.ou, std::move(value), false);
                 }
             }
         }
@@ -366,41 +438,16 @@ QPDF::filterCompressedObjects(std::map<int, int> const& object_stream_data)
         return;
     }
 
-    // Transform object_to_obj_users and obj_user_to_objects so that they refer only to uncompressed
-    // objects.  If something is a user of a compressed object, then it is really a user of the
-    // object stream that contains it.
-
-    std::map<ObjUser, std::set<QPDFObjGen>> t_obj_user_to_objects;
-    std::map<QPDFObjGen, std::set<ObjUser>> t_object_to_obj_users;
-
-    for (auto const& i1: m->obj_user_to_objects) {
-        ObjUser const& ou = i1.first;
-        // Loop over objects.
-        for (auto const& og: i1.second) {
-            auto i2 = object_stream_data.find(og.getObj());
-            if (i2 == object_stream_data.end()) {
-                t_obj_user_to_objects[ou].insert(og);
-            } else {
-                t_obj_user_to_objects[ou].insert(QPDFObjGen(i2->second, 0));
-            }
-        }
-    }
-
-    for (auto const& i1: m->object_to_obj_users) {
-        QPDFObjGen const& og = i1.first;
-        // Loop over obj_users.
-        for (auto const& ou: i1.second) {
-            auto i2 = object_stream_data.find(og.getObj());
-            if (i2 == object_stream_data.end()) {
-                t_object_to_obj_users[og].insert(ou);
-            } else {
-                t_object_to_obj_users[QPDFObjGen(i2->second, 0)].insert(ou);
-            }
+    // Transform the object user map so that it refers only to uncompressed objects.  If something
+    // is a user of a compressed object, then it is really a user of the object stream that
+    // contains it.
+    m->obj_user_map.replace_objects([&object_stream_data](QPDFObjGen& og) {
+        auto i2 = object_stream_data.find(og.getObj());
+        if (i2 != object_stream_data.end()) {
+            og = QPDFObjGen(i2->second, 0);
         }
-    }
-
-    m->obj_user_to_objects = t_obj_user_to_objects;
-    m->object_to_obj_users = t_object_to_obj_users;
+        return true;
+    });
 }
 
 void
@@ -410,43 +457,18 @@ QPDF::filterCompressedObjects(QPDFWriter::ObjTable const& obj)
         return;
     }
 
-    // Transform object_to_obj_users and obj_user_to_objects so that they refer only to uncompressed
-    // objects.  If something is a user of a compressed object, then it is really a user of the
-    // object stream that contains it.
-
-    std::map<ObjUser, std::set<QPDFObjGen>> t_obj_user_to_objects;
-    std::map<QPDFObjGen, std::set<ObjUser>> t_object_to_obj_users;
-
-    for (auto const& i1: m->obj_user_to_objects) {
-        ObjUser const& ou = i1.first;
-        // Loop over objects.
-        for (auto const& og: i1.second) {
-            if (obj.contains(og)) {
-                if (auto const& i2 = obj[og].object_stream; i2 <= 0) {
-                    t_obj_user_to_objects[ou].insert(og);
-                } else {
-                    t_obj_user_to_objects[ou].insert(QPDFObjGen(i2, 0));
-                }
-            }
+    // Transform the object user map so that it refers only to uncompressed objects.  If something
+    // is a user of a compressed object, then it is really a user of the object stream that
+    // contains it. Objects that are not in obj are dropped.
+    m->obj_user_map.replace_objects([&obj](QPDFObjGen& og) {
+        if (!obj.contains(og)) {
+            return false;
         }
-    }
-
-    for (auto const& i1: m->object_to_obj_users) {
-        QPDFObjGen const& og = i1.first;
-        if (obj.contains(og)) {
-            // Loop over obj_users.
-            for (auto const& ou: i1.second) {
-                if (auto i2 = obj[og].object_stream; i2 <= 0) {
-                    t_object_to_obj_users[og].insert(ou);
-                } else {
-                    t_object_to_obj_users[QPDFObjGen(i2, 0)].insert(ou);
-                }
-            }
+        if (auto i2 = obj[og].object_stream; i2 > 0) {
+            og = QPDFObjGen(i2, 0);
         }
-    }
-
-    m->obj_user_to_objects = t_obj_user_to_objects;
-    m->object_to_obj_users = t_object_to_obj_users;
+        return true;
+    });
 }
 
 void
@@ -457,37 +479,13 @@ QPDF::filterCompressedObjects(QPDF::Objects const& objects)
         return;
     }
 
-    // Transform object_to_obj_users and obj_user_to_objects so that they refer only to uncompressed
-    // objects.  If something is a user of a compressed object, then it is really a user of the
-    // object stream that contains it.
-
-    std::map<ObjUser, std::set<QPDFObjGen>> t_obj_user_to_objects;
-    std::map<QPDFObjGen, std::set<ObjUser>> t_object_to_obj_users;
-
-    for (auto const& i1: m->obj_user_to_objects) {
-        ObjUser const& ou = i1.first;
-        // Loop over objects.
-        for (auto const& og: i1.second) {
-            if (auto stream = xref.stream_number(og.getObj())) {
-                t_obj_user_to_objects[ou].insert(QPDFObjGen(stream, 0));
-            } else {
-                t_obj_user_to_objects[ou].insert(og);
-            }
+    // Transform the object user map so that it refers only to uncompressed objects.  If something
+    // is a user of a compressed object, then it is really a user of the object stream that
+    // contains it.
+    m->obj_user_map.replace_objects([&xref](QPDFObjGen& og) {
+        if (auto stream = xref.stream_number(og.getObj())) {
+            og = QPDFObjGen(stream, 0);
         }
-    }
-
-    for (auto const& i1: m->object_to_obj_users) {
-        QPDFObjGen const& og = i1.first;
-        // Loop over obj_users.
-        for (auto const& ou: i1.second) {
-            if (auto stream = xref.stream_number(og.getObj())) {
-                t_object_to_obj_users[QPDFObjGen(stream, 0)].insert(ou);
-            } else {
-                t_object_to_obj_users[og].insert(ou);
-            }
-        }
-    }
-
-    m->obj_user_to_objects = t_obj_user_to_objects;
-    m->object_to_obj_users = t_object_to_obj_users;
+        return true;
+    });
 }
@@ -2,43 +2,43 @@
 
 #include <qpdf/QUtil.hh>
 #include <cstdio>
-#include <map>
+#include <mutex>
 #include <set>
 
-static bool
-tc_active(char const* const scope)
+static std::string
+get_env(char const* var)
 {
     std::string value;
-    return (QUtil::get_env("TC_SCOPE", &value) && (value == scope));
+    QUtil::get_env(var, &value);
+    return value;
 }
 
 void
 QTC::TC_real(char const* const scope, char const* const ccase, int n)
 {
-    static std::map<std::string, bool> active;
-    auto is_active = active.find(scope);
-    if (is_active == active.end()) {
-        active[scope] = tc_active(scope);
-        is_active = active.find(scope);
-    }
-
-    if (!is_active->second) {
+    // The environment is only read once, so this returns without locking when coverage is not
+    // being recorded.
+    static std::string const active_scope = get_env("TC_SCOPE");
+    if (active_scope.empty() || active_scope != scope) {
         return;
     }
 
-    static std::set<std::pair<std::string, int>> cache;
-
-    std::string filename;
 #ifdef _WIN32
 # define TC_ENV "TC_WIN_FILENAME"
 #else
 # define TC_ENV "TC_FILENAME"
 #endif
-    if (!QUtil::get_env(TC_ENV, &filename)) {
+    static std::string const filename = get_env(TC_ENV);
+#undef TC_ENV
+    if (filename.empty()) {
         return;
     }
-#undef TC_ENV
 
+    // Coverage cases may be hit from worker threads.
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    static std::set<std::pair<std::string, int>> cache;
     if (cache.count(std::make_pair(ccase, n))) {
         return;
     }
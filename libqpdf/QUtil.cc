@@ -8,7 +8,9 @@
 #include <qpdf/QIntC.hh>
 #include <qpdf/QPDFSystemError.hh>
 #include <qpdf/QTC.hh>
+#include <qpdf/hex_functions.hh>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdlib>
 #include <cstring>
@@ -25,6 +27,7 @@
 # include <cwchar>
 #endif
 #ifdef _WIN32
+# define NOMINMAX
 # define WIN32_LEAN_AND_MEAN
 # include <direct.h>
 # include <io.h>
@@ -538,6 +541,35 @@ QUtil::file_can_be_opened(char const* filename)
     return false;
 }
 
+FILE*
+QUtil::temp_file()
+{
+#ifdef _WIN32
+    wchar_t dir[MAX_PATH + 1];
+    wchar_t path[MAX_PATH + 1];
+    if (GetTempPathW(MAX_PATH + 1, dir) == 0 || GetTempFileNameW(dir, L"qpd", 0, path) == 0) {
+        throw std::runtime_error("unable to create a temporary file name");
+    }
+    // T: keep the data in memory if possible; D: delete the file when it is closed
+    FILE* f = nullptr;
+# ifdef _MSC_VER
+    errno_t err = _wfopen_s(&f, path, L"w+bTD");
+    if (err != 0) {
+        errno = err;
+    }
+# else
+    f = _wfopen(path, L"w+bTD");
+# endif
+    if (f == nullptr) {
+        DeleteFileW(path);
+        throw_system_error("create temporary file");
+    }
+    return f;
+#else
+    return fopen_wrapper("create temporary file", tmpfile());
+#endif
+}
+
 int
 QUtil::seek(FILE* stream, qpdf_offset_t offset, int whence)
 {
@@ -720,13 +752,9 @@ QUtil::make_unique_cstr(std::string const& str)
 std::string
 QUtil::hex_encode(std::string const& input)
 {
-    static auto constexpr hexchars = "0123456789abcdef";
-    std::string result;
-    result.reserve(2 * input.length());
-    for (const char c: input) {
-        result += hexchars[static_cast<unsigned char>(c) >> 4];
-        result += hexchars[c & 0x0f];
-    }
+    std::string result(2 * input.length(), '\0');
+    hex_encode_block(
+        reinterpret_cast<unsigned char const*>(input.data()), input.length(), result.data());
     return result;
 }
 
@@ -736,10 +764,23 @@ QUtil::hex_decode(std::string const& input)
     std::string result;
     // We know result.size() <= 0.5 * input.size() + 1. However, reserving string space for this
     // upper bound has a negative impact.
+    auto data = reinterpret_cast<unsigned char const*>(input.data());
+    unsigned char block[512];
     bool first = true;
-    char decoded;
-    for (auto ch: input) {
-        ch = hex_decode_char(ch);
+    char decoded = 0;
+    for (size_t i = 0; i < input.size(); ++i) {
+        if (first) {
+            // Decode runs of pairs of hex digits a block at a time.
+            while (size_t n = hex_decode_block(
+                       data + i, std::min(input.size() - i, 2 * sizeof(block)), block)) {
+                result.append(reinterpret_cast<char const*>(block), n / 2);
+                i += n;
+            }
+            if (i == input.size()) {
+                break;
+            }
+        }
+        auto ch = hex_decode_char(input[i]);
         if (ch < '\20') {
             if (first) {
                 decoded = static_cast<char>(ch << 4);
@@ -0,0 +1,57 @@
+#include <qpdf/WorkerPool.hh>
+
+WorkerPool::WorkerPool(size_t n_threads)
+{
+    if (n_threads == 0) {
+        n_threads = 1;
+    }
+    threads.reserve(n_threads);
+    for (size_t i = 0; i < n_threads; ++i) {
+        threads.emplace_back([this]() { run(); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queue.clear();
+    }
+    cv.notify_all();
+    for (auto& t: threads) {
+        t.join();
+    }
+}
+
+std::future<void>
+WorkerPool::submit(std::function<void()> task)
+{
+    std::packaged_task<void()> pt(std::move(task));
+    auto result = pt.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.emplace_back(std::move(pt));
+    }
+    cv.notify_one();
+    return result;
+}
+
+void
+WorkerPool::run()
+{
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (stopping) {
+                return;
+            }
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        // packaged_task captures any exception in the associated future.
+        task();
+    }
+}
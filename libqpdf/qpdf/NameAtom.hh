@@ -0,0 +1,76 @@
+#ifndef NAMEATOM_HH
+#define NAMEATOM_HH
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+// A NameAtom refers to a shared copy of a string, normally a PDF name or dictionary key. All
+// NameAtoms created from equal strings on the same thread refer to the same copy for as long as any
+// of them exists, so the many occurrences of names like /Type and /Length in a document share their
+// storage, and most comparisons of NameAtoms only need to compare pointers. The shared copies are
+// kept in a table for each thread, so threads that create NameAtoms don't wait for each other, and
+// are freed when the last NameAtom referring to them is destroyed.
+class NameAtom
+{
+  public:
+    // An empty string
+    NameAtom();
+    explicit NameAtom(std::string_view name);
+
+    std::string const&
+    str() const noexcept
+    {
+        return *name;
+    }
+    operator std::string const&() const noexcept
+    {
+        return *name;
+    }
+
+    // NameAtoms created on different threads may refer to different copies of the same string.
+    bool
+    operator==(NameAtom const& rhs) const noexcept
+    {
+        return name == rhs.name || *name == *rhs.name;
+    }
+    bool
+    operator!=(NameAtom const& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+    friend bool
+    operator==(NameAtom const& lhs, std::string_view rhs) noexcept
+    {
+        return *lhs.name == rhs;
+    }
+    friend bool
+    operator!=(NameAtom const& lhs, std::string_view rhs) noexcept
+    {
+        return *lhs.name != rhs;
+    }
+
+    // Order by value so that containers ordered by NameAtom iterate in the same order as those
+    // ordered by std::string. The comparisons with std::string_view allow lookups in such
+    // containers that use std::less<> without creating a NameAtom.
+    bool
+    operator<(NameAtom const& rhs) const noexcept
+    {
+        return name != rhs.name && *name < *rhs.name;
+    }
+    friend bool
+    operator<(NameAtom const& lhs, std::string_view rhs) noexcept
+    {
+        return *lhs.name < rhs;
+    }
+    friend bool
+    operator<(std::string_view lhs, NameAtom const& rhs) noexcept
+    {
+        return lhs < *rhs.name;
+    }
+
+  private:
+    std::shared_ptr<std::string const> name;
+};
+
+#endif // NAMEATOM_HH
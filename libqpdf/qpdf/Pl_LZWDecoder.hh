@@ -3,7 +3,6 @@
 
 #include <qpdf/Pipeline.hh>
 
-#include <qpdf/Buffer.hh>
 #include <vector>
 
 class Pl_LZWDecoder final: public Pipeline
@@ -15,24 +14,36 @@ class Pl_LZWDecoder final: public Pipeline
     void finish() final;
 
   private:
-    void sendNextCode();
     void handleCode(unsigned int code);
     unsigned char getFirstChar(unsigned int code);
     void addToTable(unsigned char next);
+    void appendString(unsigned int code);
+    void flush();
 
     // members used for converting bits to codes
-    unsigned char buf[3]{0, 0, 0};
+    unsigned int bit_buffer{0};
     unsigned int code_size{9};
-    unsigned int next_char_{0};
-    unsigned int byte_pos{0};
-    unsigned int bit_pos{0}; // left to right: 01234567
     unsigned int bits_available{0};
 
     // members used for handle LZW decompression
     bool code_change_delta{false};
     bool eod{false};
-    std::vector<Buffer> table;
+
+    // Entry i of the table is the string for code 258 + i. It is the string for code prefix
+    // followed by suffix. Strings are rebuilt from the end by following prefixes rather than
+    // stored.
+    struct Entry
+    {
+        unsigned short prefix;
+        unsigned short length;
+        unsigned char first;
+        unsigned char suffix;
+    };
+    std::vector<Entry> table;
     unsigned int last_code{256};
+
+    // Decoded data not yet written to the next pipeline
+    std::vector<unsigned char> out;
 };
 
 #endif // PL_LZWDECODER_HH
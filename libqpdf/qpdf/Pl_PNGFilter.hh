@@ -47,6 +47,7 @@ class Pl_PNGFilter final: public Pipeline
     unsigned char* prev_row{nullptr}; // points to buf1 or buf2
     std::shared_ptr<unsigned char> buf1;
     std::shared_ptr<unsigned char> buf2;
+    std::shared_ptr<unsigned char> buf3; // encoded row
     size_t pos{0};
     size_t incoming{0};
 };
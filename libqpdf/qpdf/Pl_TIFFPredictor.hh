@@ -39,7 +39,6 @@ class Pl_TIFFPredictor: public Pipeline
     unsigned int bits_per_sample;
     std::vector<unsigned char> cur_row;
     std::vector<long long> previous;
-    std::vector<unsigned char> out;
 };
 
 #endif // PL_TIFFPREDICTOR_HH
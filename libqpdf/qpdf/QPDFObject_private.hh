@@ -6,73 +6,175 @@
 
 #include <qpdf/Constants.h>
 #include <qpdf/JSON.hh>
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/QPDF_Array.hh>
+#include <qpdf/QPDF_Bool.hh>
+#include <qpdf/QPDF_Deferred.hh>
+#include <qpdf/QPDF_Destroyed.hh>
+#include <qpdf/QPDF_Dictionary.hh>
+#include <qpdf/QPDF_InlineImage.hh>
+#include <qpdf/QPDF_Integer.hh>
+#include <qpdf/QPDF_Name.hh>
+#include <qpdf/QPDF_Null.hh>
+#include <qpdf/QPDF_Operator.hh>
+#include <qpdf/QPDF_Real.hh>
+#include <qpdf/QPDF_Reserved.hh>
+#include <qpdf/QPDF_Stream.hh>
+#include <qpdf/QPDF_String.hh>
+#include <qpdf/QPDF_Unresolved.hh>
 #include <qpdf/QPDF_private.hh>
 #include <qpdf/Types.h>
 
 #include <string>
 #include <string_view>
+#include <variant>
 
 class QPDFObjectHandle;
 
-class QPDFObject
+// A reference from one object to another object that holds its value. An indirect object that has
+// been replaced with QPDF::replaceObject refers to the object that replaced it, so that both share
+// one value. An object read from the input whose value has been moved into an existing indirect
+// object refers to that object.
+class QPDF_Reference
 {
-    friend class QPDFValue;
-
   public:
-    QPDFObject() = default;
-
-    std::shared_ptr<QPDFObject>
-    copy(bool shallow = false)
+    QPDF_Reference(std::shared_ptr<QPDFObject> obj) :
+        obj(std::move(obj))
     {
-        return value->copy(shallow);
     }
-    std::string
-    unparse()
+
+    std::shared_ptr<QPDFObject> obj;
+};
+
+// A QPDFObject holds the value of a PDF object together with its description and, for indirect
+// objects, its owning QPDF and object id. The value is held in a variant within the object itself,
+// so creating an object needs a single allocation, and the value of an indirect object can be
+// replaced without affecting handles that refer to it.
+class QPDFObject
+{
+  public:
+    struct JSON_Descr
     {
-        return value->unparse();
-    }
-    void
-    writeJSON(int json_version, JSON::Writer& p)
+        JSON_Descr(std::shared_ptr<std::string> input, std::string const& object) :
+            input(input),
+            object(object)
+        {
+        }
+
+        std::shared_ptr<std::string> input;
+        std::string object;
+    };
+
+    struct ChildDescr
+    {
+        ChildDescr(
+            std::shared_ptr<QPDFObject> parent,
+            std::string_view const& static_descr,
+            std::string var_descr) :
+            parent(parent),
+            static_descr(static_descr),
+            var_descr(var_descr)
+        {
+        }
+
+        std::weak_ptr<QPDFObject> parent;
+        std::string_view const& static_descr;
+        std::string var_descr;
+    };
+
+    using Description = std::variant<std::string, JSON_Descr, ChildDescr>;
+
+    // The alternatives are in the same order as qpdf_object_type_e so that the index of the value
+    // is its type code. QPDF_Reference and QPDF_Deferred, which have no type codes of their own,
+    // come last.
+    using Value = std::variant<
+        std::monostate,
+        QPDF_Reserved,
+        QPDF_Null,
+        QPDF_Bool,
+        QPDF_Integer,
+        QPDF_Real,
+        QPDF_String,
+        QPDF_Name,
+        QPDF_Array,
+        QPDF_Dictionary,
+        QPDF_Stream,
+        QPDF_Operator,
+        QPDF_InlineImage,
+        QPDF_Unresolved,
+        QPDF_Destroyed,
+        QPDF_Reference,
+        QPDF_Deferred>;
+
+    template <typename T>
+    explicit QPDFObject(T&& value) :
+        value(std::forward<T>(value))
     {
-        return value->writeJSON(json_version, p);
+        setStreamOwner();
     }
-    std::string
-    getStringValue() const
+    template <typename T>
+    QPDFObject(QPDF* qpdf, QPDFObjGen og, T&& value) :
+        value(std::forward<T>(value)),
+        qpdf(qpdf),
+        og(og)
     {
-        return value->getStringValue();
+        setStreamOwner();
     }
+
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
+    std::string getStringValue() const;
+
     // Return a unique type code for the resolved object
     qpdf_object_type_e
     getResolvedTypeCode() const
     {
-        auto tc = value->type_code;
-        return tc == ::ot_unresolved
-            ? QPDF::Resolver::resolved(value->qpdf, value->og)->value->type_code
-            : tc;
+        auto tc = getTypeCode();
+        return tc == ::ot_unresolved ? QPDF::Resolver::resolved(qpdf, og)->getTypeCode() : tc;
     }
     // Return a unique type code for the object
     qpdf_object_type_e
     getTypeCode() const noexcept
     {
-        return value->type_code;
+        if (auto ref = reference()) {
+            return ref->getTypeCode();
+        }
+        if (auto deferred = std::get_if<QPDF_Deferred>(&value)) {
+            return deferred->type_code;
+        }
+        return static_cast<qpdf_object_type_e>(value.index());
     }
 
     QPDF*
     getQPDF() const
     {
-        return value->qpdf;
+        if (auto ref = reference()) {
+            return ref->getQPDF();
+        }
+        return qpdf;
     }
     QPDFObjGen
     getObjGen() const
     {
-        return value->og;
+        if (auto ref = reference()) {
+            return ref->getObjGen();
+        }
+        return og;
     }
     void
     setDescription(
-        QPDF* qpdf, std::shared_ptr<QPDFValue::Description>& description, qpdf_offset_t offset = -1)
+        QPDF* a_qpdf, std::shared_ptr<Description>& description, qpdf_offset_t offset = -1)
     {
-        return value->setDescription(qpdf, description, offset);
+        if (auto ref = reference()) {
+            ref->setDescription(a_qpdf, description, offset);
+            return;
+        }
+        qpdf = a_qpdf;
+        object_description = description;
+        setParsedOffset(offset);
+        if (auto stream = std::get_if<QPDF_Stream>(&value)) {
+            stream->setDictDescription();
+        }
     }
     void
     setChildDescription(
@@ -80,107 +182,198 @@ class QPDFObject
         std::string_view const& static_descr,
         std::string var_descr)
     {
-        auto qpdf = parent ? parent->value->qpdf : nullptr;
-        value->setChildDescription(qpdf, parent->value, static_descr, var_descr);
-    }
-    void
-    setChildDescription(
-        std::shared_ptr<QPDFValue> parent,
-        std::string_view const& static_descr,
-        std::string var_descr)
-    {
-        auto qpdf = parent ? parent->qpdf : nullptr;
-        value->setChildDescription(qpdf, parent, static_descr, var_descr);
+        qpdf = parent ? parent->getQPDF() : nullptr;
+        object_description =
+            std::make_shared<Description>(ChildDescr(parent, static_descr, var_descr));
     }
+    std::string getDescription();
     bool
-    getDescription(QPDF*& qpdf, std::string& description)
+    getDescription(QPDF*& a_qpdf, std::string& description)
     {
-        qpdf = value->qpdf;
-        description = value->getDescription();
-        return qpdf != nullptr;
+        a_qpdf = getQPDF();
+        description = getDescription();
+        return a_qpdf != nullptr;
     }
     bool
     hasDescription()
     {
-        return value->hasDescription();
+        if (auto ref = reference()) {
+            return ref->hasDescription();
+        }
+        return object_description || og.isIndirect();
     }
     void
     setParsedOffset(qpdf_offset_t offset)
     {
-        value->setParsedOffset(offset);
+        if (auto ref = reference()) {
+            ref->setParsedOffset(offset);
+        } else if (parsed_offset < 0) {
+            parsed_offset = offset;
+        }
     }
     qpdf_offset_t
     getParsedOffset()
     {
-        return value->getParsedOffset();
+        if (auto ref = reference()) {
+            return ref->getParsedOffset();
+        }
+        return parsed_offset;
     }
+    // Move the value and description of this object to the object o and make this object refer to
+    // o. Used by QPDF to store objects it has just read in existing indirect objects.
     void
-    assign(std::shared_ptr<QPDFObject> o)
+    move_to(std::shared_ptr<QPDFObject> const& o)
     {
-        value = o->value;
+        if (o.get() == this) {
+            return;
+        }
+        o->value = std::move(value);
+        o->setStreamOwner();
+        o->qpdf = qpdf;
+        o->og = og;
+        o->object_description = std::move(object_description);
+        o->parsed_offset = parsed_offset;
+        value = QPDF_Reference(o);
+        qpdf = nullptr;
+        og = QPDFObjGen();
+        object_description = nullptr;
+        parsed_offset = -1;
     }
+    // Make this indirect object refer to o, which replaces it. Handles to this object see o's value
+    // from then on, and changes to o are visible through them, but o keeps its value if this object
+    // is replaced again or destroyed. An object that previously replaced this one becomes a direct
+    // object again. Used by QPDF::replaceObject.
     void
-    swapWith(std::shared_ptr<QPDFObject> o)
+    refer_to(std::shared_ptr<QPDFObject> const& o)
     {
-        auto v = value;
-        value = o->value;
-        o->value = v;
-        auto og = value->og;
-        value->og = o->value->og;
-        o->value->og = og;
+        for (auto obj = o.get(); obj; obj = obj->reference()) {
+            if (obj == this) {
+                return;
+            }
+        }
+        if (auto ref = reference()) {
+            ref->setObjGen(nullptr, QPDFObjGen());
+        }
+        value = QPDF_Reference(o);
+        object_description = nullptr;
+        parsed_offset = -1;
     }
-
+    // Replace the value of this object with null and remove its description and object id.
     void
-    setDefaultDescription(QPDF* qpdf, QPDFObjGen const& og)
+    assign_null()
     {
-        // Intended for use by the QPDF class
-        value->setDefaultDescription(qpdf, og);
+        value = QPDF_Null();
+        qpdf = nullptr;
+        og = QPDFObjGen();
+        object_description = nullptr;
+        parsed_offset = -1;
+    }
+    // Return this indirect object to the unresolved state so that its value is freed and read again
+    // from the input when it is next needed. The object keeps its owner and object id.
+    void
+    assign_unresolved()
+    {
+        value = QPDF_Unresolved();
+        object_description = nullptr;
+        parsed_offset = -1;
+    }
+    // Swap values and descriptions with o. The objects keep their object ids.
+    void
+    swapWith(std::shared_ptr<QPDFObject> o)
+    {
+        std::swap(value, o->value);
+        std::swap(qpdf, o->qpdf);
+        std::swap(object_description, o->object_description);
+        std::swap(parsed_offset, o->parsed_offset);
+        setStreamOwner();
+        o->setStreamOwner();
+        // An object that replaced one of the objects takes on the object id of the other.
+        if (auto ref = reference()) {
+            ref->setObjGen(qpdf, og);
+        }
+        if (auto ref = o->reference()) {
+            ref->setObjGen(o->qpdf, o->og);
+        }
     }
+
     void
-    setObjGen(QPDF* qpdf, QPDFObjGen const& og)
+    setDefaultDescription(QPDF* a_qpdf, QPDFObjGen const& a_og)
     {
-        value->qpdf = qpdf;
-        value->og = og;
+        // Intended for use by the QPDF class
+        qpdf = a_qpdf;
+        og = a_og;
     }
     void
-    disconnect()
+    setObjGen(QPDF* a_qpdf, QPDFObjGen const& a_og)
     {
-        // Disconnect an object from its owning QPDF. This is called by QPDF's destructor.
-        value->disconnect();
-        value->qpdf = nullptr;
-        value->og = QPDFObjGen();
+        qpdf = a_qpdf;
+        og = a_og;
     }
+    // Disconnect an object from its owning QPDF. This is called by QPDF's destructor.
+    void disconnect();
     // Mark an object as destroyed. Used by QPDF's destructor for its indirect objects.
     void destroy();
 
     bool
     isUnresolved() const
     {
-        return value->type_code == ::ot_unresolved;
+        return value.index() == ::ot_unresolved;
+    }
+    bool
+    isDeferred() const
+    {
+        return std::holds_alternative<QPDF_Deferred>(value);
     }
     const QPDFObject*
     resolved_object() const
     {
-        return isUnresolved() ? QPDF::Resolver::resolved(value->qpdf, value->og) : this;
+        if (auto ref = reference()) {
+            return ref->resolved_object();
+        }
+        return isUnresolved() ? QPDF::Resolver::resolved(qpdf, og) : this;
     }
 
     template <typename T>
     T*
-    as() const
+    as()
     {
-        if (auto result = dynamic_cast<T*>(value.get())) {
+        if (auto result = std::get_if<T>(&value)) {
             return result;
+        } else if (auto ref = reference()) {
+            return ref->as<T>();
+        } else if (isDeferred()) {
+            parseDeferred();
+            return std::get_if<T>(&value);
         } else {
-            return isUnresolved()
-                ? dynamic_cast<T*>(QPDF::Resolver::resolved(value->qpdf, value->og)->value.get())
-                : nullptr;
+            return isUnresolved() ? QPDF::Resolver::resolved(qpdf, og)->as<T>() : nullptr;
         }
     }
 
   private:
     QPDFObject(QPDFObject const&) = delete;
     QPDFObject& operator=(QPDFObject const&) = delete;
-    std::shared_ptr<QPDFValue> value;
+
+    QPDFObject*
+    reference() const noexcept
+    {
+        auto ref = std::get_if<QPDF_Reference>(&value);
+        return ref ? ref->obj.get() : nullptr;
+    }
+    // Replace a deferred value with the parsed array or dictionary.
+    void parseDeferred();
+    void
+    setStreamOwner()
+    {
+        if (auto stream = std::get_if<QPDF_Stream>(&value)) {
+            stream->m->obj = this;
+        }
+    }
+
+    Value value;
+    std::shared_ptr<Description> object_description;
+    QPDF* qpdf{nullptr};
+    QPDFObjGen og{};
+    qpdf_offset_t parsed_offset{-1};
 };
 
 #endif // QPDFOBJECT_HH
@@ -1,8 +1,11 @@
 #ifndef QPDFPARSER_HH
 #define QPDFPARSER_HH
 
+#include <qpdf/NameAtom.hh>
 #include <qpdf/QPDFObjectHandle.hh>
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/QPDFObject_private.hh>
+#include <qpdf/QPDFTokenizer_private.hh>
+#include <qpdf/QPDF_Dictionary.hh>
 
 #include <memory>
 #include <string>
@@ -17,15 +20,17 @@ class QPDFParser
         QPDFTokenizer& tokenizer,
         QPDFObjectHandle::StringDecrypter* decrypter,
         QPDF* context,
-        bool parse_pdf) :
+        bool parse_pdf,
+        std::shared_ptr<QPDF::DeferredInput> deferred_input = nullptr) :
         input(input),
         object_description(object_description),
         tokenizer(tokenizer),
         decrypter(decrypter),
         context(context),
-        description(std::make_shared<QPDFValue::Description>(
+        description(std::make_shared<QPDFObject::Description>(
             std::string(input.getName() + ", " + object_description + " at offset $PO"))),
-        parse_pdf(parse_pdf)
+        parse_pdf(parse_pdf),
+        deferred_input(std::move(deferred_input))
     {
     }
     virtual ~QPDFParser() = default;
@@ -46,9 +51,9 @@ class QPDFParser
         }
 
         std::vector<std::shared_ptr<QPDFObject>> olist;
-        std::map<std::string, QPDFObjectHandle> dict;
+        QPDF_Dictionary::Items dict;
         parser_state_e state;
-        std::string key;
+        NameAtom key;
         qpdf_offset_t offset;
         std::string contents_string;
         qpdf_offset_t contents_offset{-1};
@@ -56,6 +61,7 @@ class QPDFParser
     };
 
     QPDFObjectHandle parseRemainder(bool content_stream);
+    bool defer(bool is_array);
     void add(std::shared_ptr<QPDFObject>&& obj);
     void addNull();
     void addInt(int count);
@@ -75,10 +81,14 @@ class QPDFParser
     InputSource& input;
     std::string const& object_description;
     QPDFTokenizer& tokenizer;
+    // The values of the most recent token read by tokenizer.
+    QPDFTokenizer::Views token;
     QPDFObjectHandle::StringDecrypter* decrypter;
     QPDF* context;
-    std::shared_ptr<QPDFValue::Description> description;
+    std::shared_ptr<QPDFObject::Description> description;
     bool parse_pdf;
+    // If set, the parsing of large nested arrays and dictionaries is deferred.
+    std::shared_ptr<QPDF::DeferredInput> deferred_input;
 
     std::vector<StackFrame> stack;
     StackFrame* frame;
@@ -0,0 +1,18 @@
+#ifndef QPDFTOKENIZER_PRIVATE_HH
+#define QPDFTOKENIZER_PRIVATE_HH
+
+#include <qpdf/QPDFTokenizer.hh>
+
+#include <string_view>
+
+// The value and raw value of the token most recently read by QPDFTokenizer::nextToken. Except for
+// strings and tokens finished by the state machine, they refer directly to the input source's data
+// rather than to the tokenizer's buffers, so they are only valid while the input source exists and
+// until another QPDFTokenizer method is called.
+struct QPDFTokenizer::Views
+{
+    std::string_view value;
+    std::string_view raw_value;
+};
+
+#endif // QPDFTOKENIZER_PRIVATE_HH
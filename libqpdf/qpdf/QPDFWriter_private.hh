@@ -4,6 +4,10 @@
 #include <qpdf/QPDFWriter.hh>
 
 #include <qpdf/ObjTable.hh>
+#include <qpdf/WorkerPool.hh>
+
+#include <chrono>
+#include <future>
 
 // This file is intended for inclusion by QPDFWriter, QPDF, QPDF_optimization and QPDF_linearization
 // only.
@@ -42,6 +46,44 @@ class QPDFWriter::NewObjTable: public ::ObjTable<QPDFWriter::NewObject>
     friend class QPDFWriter;
 };
 
+// Data computed in the first pass of writing a linearized file that is kept for the second pass.
+// Up to memory_limit bytes are kept in memory. If use_file is set, data that doesn't fit is written
+// to a temporary file instead. Otherwise it is not kept at all.
+class LinearizationCache
+{
+  public:
+    // If data is null, the item is stored in the temporary file at the given offset.
+    struct Item
+    {
+        std::shared_ptr<Buffer> data;
+        qpdf_offset_t offset{0};
+        size_t size{0};
+    };
+
+    LinearizationCache() = default;
+    LinearizationCache(LinearizationCache const&) = delete;
+    LinearizationCache& operator=(LinearizationCache const&) = delete;
+    ~LinearizationCache();
+
+    // Create the temporary file if use_file is set. If it can't be created, clear use_file and
+    // return false.
+    bool openFile();
+    // Return false if data can't be kept.
+    bool store(std::shared_ptr<Buffer> const& data, Item& item);
+    std::shared_ptr<Buffer> load(Item const& item);
+    // Call when item is no longer needed.
+    void release(Item const& item);
+    void clear();
+
+    size_t memory_limit{0};
+    bool use_file{false};
+
+  private:
+    size_t memory_used{0};
+    FILE* file{nullptr};
+    qpdf_offset_t file_size{0};
+};
+
 class QPDFWriter::Members
 {
     friend class QPDFWriter;
@@ -51,6 +93,45 @@ class QPDFWriter::Members
     ~Members();
 
   private:
+    // Stream data that has been filtered ahead of the serial output pass. If compressed is valid,
+    // data is replaced by its compressed form once the worker pool has run the compression task.
+    struct Prefiltered
+    {
+        bool filtered{false};
+        bool compress_stream{false};
+        bool is_metadata{false};
+        std::shared_ptr<Buffer> data;
+        std::future<void> compressed;
+    };
+
+    // Results kept between the two passes of writing a linearized file.
+    struct CachedStream
+    {
+        bool filtered{false};
+        bool compress_stream{false};
+        bool is_metadata{false};
+        LinearizationCache::Item data;
+    };
+    struct CachedObjectStream
+    {
+        LinearizationCache::Item data;
+        size_t n{0};
+        qpdf_offset_t first{0};
+        bool compressed{false};
+    };
+
+    // Stream data to be written directly to the output. If raw is true, the data is copied from
+    // the given range of the input file. Otherwise it is piped from the stream with the given
+    // encoding flags and decode level, which don't require any decoding.
+    struct Unbuffered
+    {
+        bool raw{false};
+        qpdf_offset_t offset{0};
+        size_t length{0};
+        int encode_flags{0};
+        qpdf_stream_decode_level_e decode_level{qpdf_dl_none};
+    };
+
     Members(QPDF& pdf);
     Members(Members const&) = delete;
 
@@ -74,6 +155,8 @@ class QPDFWriter::Members
     bool static_id{false};
     bool suppress_original_object_ids{false};
     bool direct_stream_lengths{true};
+    bool indirect_stream_lengths{false};
+    bool release_written_objects{false};
     bool encrypted{false};
     bool preserve_encryption{true};
     bool linearized{false};
@@ -106,6 +189,8 @@ class QPDFWriter::Members
     int next_objid{1};
     int cur_stream_length_id{0};
     size_t cur_stream_length{0};
+    // How to write stream data that willFilterStream has chosen not to buffer
+    Unbuffered unbuffered;
     bool added_newline{false};
     size_t max_ostream_index{0};
     std::set<QPDFObjGen> normalized_streams;
@@ -121,6 +206,22 @@ class QPDFWriter::Members
 
     // For linearization only
     std::string lin_pass1_filename;
+    std::function<void(std::string const&, double)> lin_timer;
+    std::chrono::steady_clock::time_point lin_phase_start;
+    // While fill_lin_cache is set, filtered stream data and the contents of object streams are
+    // kept in lin_cache once they have been computed so that the second pass can reuse them.
+    // Entries are removed when they are used while fill_lin_cache is not set.
+    LinearizationCache lin_cache;
+    bool fill_lin_cache{false};
+    std::map<QPDFObjGen, CachedStream> lin_streams;
+    std::map<int, CachedObjectStream> lin_object_streams;
+
+    // For parallel stream compression. worker_pool must be declared after prefiltered so that it
+    // is destroyed first; its tasks refer to entries in prefiltered.
+    int compression_threads{0};
+    std::map<QPDFObjGen, Prefiltered> prefiltered;
+    size_t prefilter_next{0};
+    std::unique_ptr<WorkerPool> worker_pool;
 
     // For progress reporting
     std::shared_ptr<QPDFWriter::ProgressReporter> progress_reporter;
@@ -1,12 +1,16 @@
 #ifndef QPDF_ARRAY_HH
 #define QPDF_ARRAY_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/JSON.hh>
 
 #include <map>
 #include <vector>
 
-class QPDF_Array: public QPDFValue
+class QPDF;
+class QPDFObject;
+class QPDFObjectHandle;
+
+class QPDF_Array
 {
   private:
     struct Sparse
@@ -16,14 +20,13 @@ class QPDF_Array: public QPDFValue
     };
 
   public:
-    ~QPDF_Array() override = default;
     static std::shared_ptr<QPDFObject> create(std::vector<QPDFObjectHandle> const& items);
     static std::shared_ptr<QPDFObject>
     create(std::vector<std::shared_ptr<QPDFObject>>&& items, bool sparse);
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
-    void writeJSON(int json_version, JSON::Writer& p) override;
-    void disconnect() override;
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
+    void disconnect();
 
     int
     size() const noexcept
@@ -31,20 +34,25 @@ class QPDF_Array: public QPDFValue
         return sp ? sp->size : int(elements.size());
     }
     std::pair<bool, QPDFObjectHandle> at(int n) const noexcept;
-    bool setAt(int n, QPDFObjectHandle const& oh);
+    // The mutators take the QPDF that owns the array, if any, and refuse items that belong to a
+    // different QPDF.
+    bool setAt(int n, QPDFObjectHandle const& oh, QPDF* qpdf);
     std::vector<QPDFObjectHandle> getAsVector() const;
-    void setFromVector(std::vector<QPDFObjectHandle> const& items);
-    bool insert(int at, QPDFObjectHandle const& item);
-    void push_back(QPDFObjectHandle const& item);
+    void setFromVector(std::vector<QPDFObjectHandle> const& items, QPDF* qpdf);
+    bool insert(int at, QPDFObjectHandle const& item, QPDF* qpdf);
+    void push_back(QPDFObjectHandle const& item, QPDF* qpdf);
     bool erase(int at);
 
+    QPDF_Array(QPDF_Array&&) = default;
+    QPDF_Array& operator=(QPDF_Array&&) = default;
+
   private:
-    QPDF_Array();
+    QPDF_Array() = default;
     QPDF_Array(QPDF_Array const&);
     QPDF_Array(std::vector<QPDFObjectHandle> const& items);
     QPDF_Array(std::vector<std::shared_ptr<QPDFObject>>&& items, bool sparse);
 
-    void checkOwnership(QPDFObjectHandle const& item) const;
+    static void checkOwnership(QPDF* qpdf, QPDFObjectHandle const& item);
 
     std::unique_ptr<Sparse> sp;
     std::vector<std::shared_ptr<QPDFObject>> elements;
@@ -1,16 +1,17 @@
 #ifndef QPDF_BOOL_HH
 #define QPDF_BOOL_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/JSON.hh>
 
-class QPDF_Bool: public QPDFValue
+class QPDFObject;
+
+class QPDF_Bool
 {
   public:
-    ~QPDF_Bool() override = default;
     static std::shared_ptr<QPDFObject> create(bool val);
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
-    void writeJSON(int json_version, JSON::Writer& p) override;
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
 
     bool getVal() const;
 
@@ -0,0 +1,29 @@
+#ifndef QPDF_DEFERRED_HH
+#define QPDF_DEFERRED_HH
+
+#include <qpdf/Constants.h>
+#include <qpdf/QPDF.hh>
+
+#include <memory>
+
+class QPDFObject;
+
+// The value of an array or dictionary read with lazy parsing enabled whose contents have not been
+// parsed yet. QPDFObject parses the contents when they are first needed and replaces this value
+// with them.
+class QPDF_Deferred
+{
+  public:
+    static std::shared_ptr<QPDFObject> create(
+        std::shared_ptr<QPDF::DeferredInput> input,
+        qpdf_offset_t offset,
+        qpdf_object_type_e type_code);
+
+    std::shared_ptr<QPDF::DeferredInput> input;
+    // The offset of the opening delimiter.
+    qpdf_offset_t offset;
+    // ::ot_array or ::ot_dictionary
+    qpdf_object_type_e type_code;
+};
+
+#endif // QPDF_DEFERRED_HH
@@ -1,19 +1,21 @@
 #ifndef QPDF_DESTROYED_HH
 #define QPDF_DESTROYED_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/JSON.hh>
 
-class QPDF_Destroyed: public QPDFValue
+class QPDFObject;
+
+class QPDF_Destroyed
 {
+    friend class QPDFObject;
+
   public:
-    ~QPDF_Destroyed() override = default;
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
-    void writeJSON(int json_version, JSON::Writer& p) override;
-    static std::shared_ptr<QPDFValue> getInstance();
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
 
   private:
-    QPDF_Destroyed();
+    QPDF_Destroyed() = default;
 };
 
 #endif // QPDF_DESTROYED_HH
@@ -1,30 +1,84 @@
 #ifndef QPDF_DICTIONARY_HH
 #define QPDF_DICTIONARY_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/JSON.hh>
 
 #include <map>
 #include <set>
+#include <vector>
 
+#include <qpdf/NameAtom.hh>
 #include <qpdf/QPDFObjectHandle.hh>
 
-class QPDF_Dictionary: public QPDFValue
+class QPDFObject;
+
+class QPDF_Dictionary
 {
   public:
-    ~QPDF_Dictionary() override = default;
+    // The items of a dictionary, in key order. Most dictionaries have only a few keys, so keep them
+    // in a sorted vector, which needs one allocation rather than one per key and is faster to
+    // search. Switch to a std::map for dictionaries with more than large_size keys so that adding
+    // keys to very large dictionaries doesn't take quadratic time.
+    class Items
+    {
+      public:
+        Items() = default;
+        Items(Items const&);
+        Items(Items&&) = default;
+        Items& operator=(Items const&) = delete;
+        Items& operator=(Items&&) = default;
+
+        // Return the value for key or nullptr if key is not present.
+        QPDFObjectHandle* find(std::string_view key);
+        // Add or replace the value for key. Return true if key was added.
+        bool insert_or_assign(NameAtom const& key, QPDFObjectHandle value);
+        bool insert_or_assign(std::string_view key, QPDFObjectHandle value);
+        void erase(std::string_view key);
+
+        // Call fn(NameAtom const& key, QPDFObjectHandle& value) for each item in key order.
+        template <typename F>
+        void
+        for_each(F&& fn)
+        {
+            if (large) {
+                for (auto& item: *large) {
+                    fn(item.first, item.second);
+                }
+            } else {
+                for (auto& item: small) {
+                    fn(item.first, item.second);
+                }
+            }
+        }
+
+      private:
+        static constexpr size_t large_size = 256;
+
+        using Small = std::vector<std::pair<NameAtom, QPDFObjectHandle>>;
+        Small::iterator lower_bound(std::string_view key);
+
+        Small small;
+        std::unique_ptr<std::map<NameAtom, QPDFObjectHandle, std::less<>>> large;
+    };
+
     static std::shared_ptr<QPDFObject> create(std::map<std::string, QPDFObjectHandle> const& items);
-    static std::shared_ptr<QPDFObject> create(std::map<std::string, QPDFObjectHandle>&& items);
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
-    void writeJSON(int json_version, JSON::Writer& p) override;
-    void disconnect() override;
-
-    // hasKey() and getKeys() treat keys with null values as if they aren't there.  getKey() returns
-    // null for the value of a non-existent key.  This is as per the PDF spec.
+    static std::shared_ptr<QPDFObject> create(Items&& items);
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
+    void disconnect();
+
+    // hasKey() and getKeys() treat keys with null values as if they aren't there.  This is as per
+    // the PDF spec.
     bool hasKey(std::string const&);
-    QPDFObjectHandle getKey(std::string const&);
+    // Return the value of key, which may be a null object, or nullptr if key does not exist.
+    QPDFObjectHandle*
+    find(std::string const& key)
+    {
+        return items.find(key);
+    }
     std::set<std::string> getKeys();
-    std::map<std::string, QPDFObjectHandle> const& getAsMap() const;
+    std::map<std::string, QPDFObjectHandle> getAsMap();
 
     // If value is null, remove key; otherwise, replace the value of key, adding it if it does not
     // exist.
@@ -33,9 +87,8 @@ class QPDF_Dictionary: public QPDFValue
     void removeKey(std::string const& key);
 
   private:
-    QPDF_Dictionary(std::map<std::string, QPDFObjectHandle> const& items);
-    QPDF_Dictionary(std::map<std::string, QPDFObjectHandle>&& items);
-    std::map<std::string, QPDFObjectHandle> items;
+    QPDF_Dictionary(Items&& items);
+    Items items;
 };
 
 #endif // QPDF_DICTIONARY_HH
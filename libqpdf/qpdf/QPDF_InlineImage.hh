@@ -1,18 +1,19 @@
 #ifndef QPDF_INLINEIMAGE_HH
 #define QPDF_INLINEIMAGE_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/JSON.hh>
 
-class QPDF_InlineImage: public QPDFValue
+class QPDFObject;
+
+class QPDF_InlineImage
 {
   public:
-    ~QPDF_InlineImage() override = default;
     static std::shared_ptr<QPDFObject> create(std::string const& val);
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
-    void writeJSON(int json_version, JSON::Writer& p) override;
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
     std::string
-    getStringValue() const override
+    getStringValue() const
     {
         return val;
     }
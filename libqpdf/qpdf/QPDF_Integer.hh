@@ -1,16 +1,17 @@
 #ifndef QPDF_INTEGER_HH
 #define QPDF_INTEGER_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/JSON.hh>
 
-class QPDF_Integer: public QPDFValue
+class QPDFObject;
+
+class QPDF_Integer
 {
   public:
-    ~QPDF_Integer() override = default;
     static std::shared_ptr<QPDFObject> create(long long value);
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
-    void writeJSON(int json_version, JSON::Writer& p) override;
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
     long long getVal() const;
 
   private:
@@ -1,16 +1,18 @@
 #ifndef QPDF_NAME_HH
 #define QPDF_NAME_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/JSON.hh>
+#include <qpdf/NameAtom.hh>
 
-class QPDF_Name: public QPDFValue
+class QPDFObject;
+
+class QPDF_Name
 {
   public:
-    ~QPDF_Name() override = default;
-    static std::shared_ptr<QPDFObject> create(std::string const& name);
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
-    void writeJSON(int json_version, JSON::Writer& p) override;
+    static std::shared_ptr<QPDFObject> create(std::string_view name);
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
 
     // Put # into strings with characters unsuitable for name token
     static std::string normalizeName(std::string const& name);
@@ -20,14 +22,15 @@ class QPDF_Name: public QPDFValue
     // characters require or {true, false} if escaping is required.
     static std::pair<bool, bool> analyzeJSONEncoding(std::string const& name);
     std::string
-    getStringValue() const override
+    getStringValue() const
     {
         return name;
     }
 
   private:
-    QPDF_Name(std::string const& name);
-    std::string name;
+    QPDF_Name(std::string_view name);
+    QPDF_Name(NameAtom const& name);
+    NameAtom name;
 };
 
 #endif // QPDF_NAME_HH
@@ -1,24 +1,25 @@
 #ifndef QPDF_OPERATOR_HH
 #define QPDF_OPERATOR_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/JSON.hh>
 
-class QPDF_Operator: public QPDFValue
+class QPDFObject;
+
+class QPDF_Operator
 {
   public:
-    ~QPDF_Operator() override = default;
-    static std::shared_ptr<QPDFObject> create(std::string const& val);
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
-    void writeJSON(int json_version, JSON::Writer& p) override;
+    static std::shared_ptr<QPDFObject> create(std::string_view val);
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
     std::string
-    getStringValue() const override
+    getStringValue() const
     {
         return val;
     }
 
   private:
-    QPDF_Operator(std::string const& val);
+    QPDF_Operator(std::string_view val);
     std::string val;
 };
 
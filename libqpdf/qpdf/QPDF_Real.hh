@@ -1,26 +1,27 @@
 #ifndef QPDF_REAL_HH
 #define QPDF_REAL_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/JSON.hh>
 
-class QPDF_Real: public QPDFValue
+class QPDFObject;
+
+class QPDF_Real
 {
   public:
-    ~QPDF_Real() override = default;
-    static std::shared_ptr<QPDFObject> create(std::string const& val);
+    static std::shared_ptr<QPDFObject> create(std::string_view val);
     static std::shared_ptr<QPDFObject>
     create(double value, int decimal_places, bool trim_trailing_zeroes);
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
-    void writeJSON(int json_version, JSON::Writer& p) override;
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
     std::string
-    getStringValue() const override
+    getStringValue() const
     {
         return val;
     }
 
   private:
-    QPDF_Real(std::string const& val);
+    QPDF_Real(std::string_view val);
     QPDF_Real(double value, int decimal_places, bool trim_trailing_zeroes);
     // Store reals as strings to avoid roundoff errors.
     std::string val;
@@ -1,19 +1,20 @@
 #ifndef QPDF_RESERVED_HH
 #define QPDF_RESERVED_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/JSON.hh>
 
-class QPDF_Reserved: public QPDFValue
+class QPDFObject;
+
+class QPDF_Reserved
 {
   public:
-    ~QPDF_Reserved() override = default;
     static std::shared_ptr<QPDFObject> create();
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
-    void writeJSON(int json_version, JSON::Writer& p) override;
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
 
   private:
-    QPDF_Reserved();
+    QPDF_Reserved() = default;
 };
 
 #endif // QPDF_RESERVED_HH
@@ -3,28 +3,28 @@
 
 #include <qpdf/Types.h>
 
+#include <qpdf/JSON.hh>
 #include <qpdf/QPDFObjectHandle.hh>
 #include <qpdf/QPDFStreamFilter.hh>
-#include <qpdf/QPDFValue.hh>
 
 #include <functional>
 #include <memory>
 
 class Pipeline;
 class QPDF;
+class QPDFObject;
 
-class QPDF_Stream final: public QPDFValue
+class QPDF_Stream
 {
+    friend class QPDFObject;
+
   public:
-    ~QPDF_Stream() final = default;
     static std::shared_ptr<QPDFObject>
     create(QPDF*, QPDFObjGen og, QPDFObjectHandle stream_dict, qpdf_offset_t offset, size_t length);
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) final;
-    std::string unparse() final;
-    void writeJSON(int json_version, JSON::Writer& p) final;
-    void setDescription(
-        QPDF*, std::shared_ptr<QPDFValue::Description>& description, qpdf_offset_t offset) final;
-    void disconnect() final;
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
+    void writeJSON(int json_version, JSON::Writer& p);
+    void disconnect();
     QPDFObjectHandle getDict() const;
     bool isDataModified() const;
     void setFilterOnWrite(bool);
@@ -34,6 +34,9 @@ class QPDF_Stream final: public QPDFValue
     size_t getLength() const;
     std::shared_ptr<Buffer> getStreamDataBuffer() const;
     std::shared_ptr<QPDFObjectHandle::StreamDataProvider> getStreamDataProvider() const;
+    // If the stream's data is the unmodified data from the input file, return true and set offset
+    // and length to its location in the file.
+    bool getInputDataRange(qpdf_offset_t& offset, size_t& length) const;
 
     // See comments in QPDFObjectHandle.hh for these methods.
     bool pipeStreamData(
@@ -75,8 +78,22 @@ class QPDF_Stream final: public QPDFValue
         std::string const& filter_name, std::function<std::shared_ptr<QPDFStreamFilter>()> factory);
 
   private:
-    QPDF_Stream(
-        QPDF*, QPDFObjGen og, QPDFObjectHandle stream_dict, qpdf_offset_t offset, size_t length);
+    struct Members
+    {
+        Members(QPDFObjectHandle stream_dict, size_t length);
+
+        // The object holding this stream, which provides its owner, object id, description and
+        // offset. Maintained by QPDFObject.
+        QPDFObject* obj{nullptr};
+        bool filter_on_write{true};
+        QPDFObjectHandle stream_dict;
+        size_t length{0};
+        std::shared_ptr<Buffer> stream_data;
+        std::shared_ptr<QPDFObjectHandle::StreamDataProvider> stream_provider;
+        std::vector<std::shared_ptr<QPDFObjectHandle::TokenFilter>> token_filters;
+    };
+
+    QPDF_Stream(QPDFObjectHandle stream_dict, size_t length);
     static std::map<std::string, std::string> filter_abbreviations;
     static std::map<std::string, std::function<std::shared_ptr<QPDFStreamFilter>()>>
         filter_factories;
@@ -90,12 +107,7 @@ class QPDF_Stream final: public QPDFValue
     void warn(std::string const& message);
     void setDictDescription();
 
-    bool filter_on_write;
-    QPDFObjectHandle stream_dict;
-    size_t length;
-    std::shared_ptr<Buffer> stream_data;
-    std::shared_ptr<QPDFObjectHandle::StreamDataProvider> stream_provider;
-    std::vector<std::shared_ptr<QPDFObjectHandle::TokenFilter>> token_filters;
+    std::unique_ptr<Members> m;
 };
 
 #endif // QPDF_STREAM_HH
@@ -1,25 +1,26 @@
 #ifndef QPDF_STRING_HH
 #define QPDF_STRING_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/JSON.hh>
+
+class QPDFObject;
 
 // QPDF_Strings may included embedded null characters.
 
-class QPDF_String: public QPDFValue
+class QPDF_String
 {
     friend class QPDFWriter;
 
   public:
-    ~QPDF_String() override = default;
     static std::shared_ptr<QPDFObject> create(std::string const& val);
     static std::shared_ptr<QPDFObject> create_utf16(std::string const& utf8_val);
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
+    std::shared_ptr<QPDFObject> copy(bool shallow = false);
+    std::string unparse();
     std::string unparse(bool force_binary);
-    void writeJSON(int json_version, JSON::Writer& p) override;
+    void writeJSON(int json_version, JSON::Writer& p);
     std::string getUTF8Val() const;
     std::string
-    getStringValue() const override
+    getStringValue() const
     {
         return val;
     }
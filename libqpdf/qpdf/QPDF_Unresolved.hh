@@ -1,20 +1,19 @@
 #ifndef QPDF_UNRESOLVED_HH
 #define QPDF_UNRESOLVED_HH
 
-#include <qpdf/QPDFValue.hh>
+#include <qpdf/QPDFObjGen.hh>
 
-class QPDF_Unresolved: public QPDFValue
+#include <memory>
+
+class QPDF;
+class QPDFObject;
+
+// The value of an indirect object that has not been read yet. QPDFObject resolves it using its
+// owning QPDF and object id when its value is needed.
+class QPDF_Unresolved
 {
   public:
-    ~QPDF_Unresolved() override = default;
     static std::shared_ptr<QPDFObject> create(QPDF* qpdf, QPDFObjGen const& og);
-    std::shared_ptr<QPDFObject> copy(bool shallow = false) override;
-    std::string unparse() override;
-    void writeJSON(int json_version, JSON::Writer& p) override;
-    std::string getStringValue() const override;
-
-  private:
-    QPDF_Unresolved(QPDF* qpdf, QPDFObjGen const& og);
 };
 
 #endif // QPDF_UNRESOLVED_HH
@@ -6,7 +6,9 @@
 #include <qpdf/QPDF_Null.hh>
 #include <qpdf/QPDF_Unresolved.hh>
 
-#include <variant>
+#include <iterator>
+
+class QPDF_Deferred;
 
 // The Objects class is responsible for keeping track of all objects belonging to a QPDF instance,
 // including loading it from an input source when required.
@@ -72,6 +74,16 @@ class QPDF::Objects
             return table[id].type();
         }
 
+        // Returns 0 if id is not in table.
+        int
+        gen(size_t id) const noexcept
+        {
+            if (id >= table.size()) {
+                return 0;
+            }
+            return table[id].gen();
+        }
+
         // Returns 0 if og is not in table.
         qpdf_offset_t
         offset(QPDFObjGen og) const noexcept
@@ -104,6 +116,81 @@ class QPDF::Objects
 
         QPDFObjGen at_offset(qpdf_offset_t offset) const noexcept;
 
+        // Iterates over the entries of the table that are in use in order of object number,
+        // yielding each object's QPDFObjGen and QPDFXRefEntry.
+        class const_iterator
+        {
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<QPDFObjGen, QPDFXRefEntry>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            value_type operator*() const;
+
+            const_iterator&
+            operator++() noexcept
+            {
+                ++id;
+                skip_free();
+                return *this;
+            }
+
+            const_iterator
+            operator++(int) noexcept
+            {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            bool
+            operator==(const_iterator const& rhs) const noexcept
+            {
+                return id == rhs.id;
+            }
+
+            bool
+            operator!=(const_iterator const& rhs) const noexcept
+            {
+                return id != rhs.id;
+            }
+
+          private:
+            friend class Xref_table;
+
+            const_iterator(Xref_table const& xref, size_t id) noexcept :
+                xref(&xref),
+                id(id)
+            {
+                skip_free();
+            }
+
+            void
+            skip_free() noexcept
+            {
+                while (id < xref->table.size() && !xref->table[id].type()) {
+                    ++id;
+                }
+            }
+
+            Xref_table const* xref;
+            size_t id;
+        };
+
+        const_iterator
+        begin() const noexcept
+        {
+            return {*this, 0};
+        }
+
+        const_iterator
+        end() const noexcept
+        {
+            return {*this, table.size()};
+        }
+
         std::map<QPDFObjGen, QPDFXRefEntry> as_map() const;
 
         bool
@@ -167,48 +254,19 @@ class QPDF::Objects
         // For Linearization
 
         qpdf_offset_t
-        end_after_space(QPDFObjGen og)
-        {
-            auto& e = entry(toS(og.getObj()));
-            switch (e.type()) {
-            case 1:
-                return e.end_after_space_;
-            case 2:
-                {
-                    auto es = entry(toS(e.stream_number()));
-                    return es.type() == 1 ? es.end_after_space_ : 0;
-                }
-            default:
-                return 0;
-            }
+        end_after_space(QPDFObjGen og) const
+        {
+            return object_end(og, true);
         }
 
         qpdf_offset_t
-        end_before_space(QPDFObjGen og)
-        {
-            auto& e = entry(toS(og.getObj()));
-            switch (e.type()) {
-            case 1:
-                return e.end_before_space_;
-            case 2:
-                {
-                    auto es = entry(toS(e.stream_number()));
-                    return es.type() == 1 ? es.end_before_space_ : 0;
-                }
-            default:
-                return 0;
-            }
-        }
-
-        void
-        linearization_offsets(size_t id, qpdf_offset_t before, qpdf_offset_t after)
+        end_before_space(QPDFObjGen og) const
         {
-            if (type(id)) {
-                table[id].end_before_space_ = before;
-                table[id].end_after_space_ = after;
-            }
+            return object_end(og, false);
         }
 
+        void linearization_offsets(size_t id, qpdf_offset_t before, qpdf_offset_t after);
+
         bool
         uncompressed_after_compressed() const noexcept
         {
@@ -226,78 +284,97 @@ class QPDF::Objects
         // Object, count, offset of first entry
         typedef std::tuple<int, int, qpdf_offset_t> Subsection;
 
-        struct Uncompressed
+        // A table entry packed into 12 bytes. For uncompressed objects the two value words hold
+        // the offset, and for compressed objects they hold the number of the object stream and
+        // the index of the object within it. The low two bits of bits_ hold the type and the rest
+        // the generation.
+        class Entry
         {
-            Uncompressed(qpdf_offset_t offset) :
-                offset(offset)
+          public:
+            Entry() = default;
+
+            static Entry
+            uncompressed(int gen, qpdf_offset_t offset) noexcept
             {
+                auto value = static_cast<uint64_t>(offset);
+                return {
+                    static_cast<uint32_t>(value),
+                    static_cast<uint32_t>(value >> 32),
+                    gen,
+                    1};
             }
-            qpdf_offset_t offset;
-        };
 
-        struct Compressed
-        {
-            Compressed(int stream_number, int stream_index) :
-                stream_number(stream_number),
-                stream_index(stream_index)
+            static Entry
+            compressed(int stream_number, int stream_index) noexcept
             {
+                return {
+                    static_cast<uint32_t>(stream_number),
+                    static_cast<uint32_t>(stream_index),
+                    0,
+                    2};
             }
-            int stream_number{0};
-            int stream_index{0};
-        };
 
-        typedef std::variant<std::monostate, Uncompressed, Compressed> Xref;
-
-        struct Entry
-        {
-            Entry() = default;
-
-            Entry(int gen, Xref entry) :
-                gen_(gen),
-                entry(entry)
+            static Entry
+            free(int gen) noexcept
             {
+                return {0, 0, gen, 0};
             }
 
             int
             gen() const noexcept
             {
-                return gen_;
+                return static_cast<int>(bits_ >> 2);
             }
 
             size_t
             type() const noexcept
             {
-                return entry.index();
+                return bits_ & 3U;
             }
 
             qpdf_offset_t
             offset() const noexcept
             {
-                return type() == 1 ? std::get<1>(entry).offset : 0;
+                return type() == 1
+                    ? static_cast<qpdf_offset_t>((static_cast<uint64_t>(value2_) << 32) | value1_)
+                    : 0;
             }
 
             int
             stream_number() const noexcept
             {
-                return type() == 2 ? std::get<2>(entry).stream_number : 0;
+                return type() == 2 ? static_cast<int>(value1_) : 0;
             }
 
             int
             stream_index() const noexcept
             {
-                return type() == 2 ? std::get<2>(entry).stream_index : 0;
+                return type() == 2 ? static_cast<int>(value2_) : 0;
             }
 
-            int gen_{0};
-            Xref entry;
-            qpdf_offset_t end_before_space_{0};
-            qpdf_offset_t end_after_space_{0};
+          private:
+            Entry(uint32_t value1, uint32_t value2, int gen, uint32_t type) noexcept :
+                value1_(value1),
+                value2_(value2),
+                bits_((static_cast<uint32_t>(gen) << 2) | type)
+            {
+            }
+
+            uint32_t value1_{0};
+            uint32_t value2_{0};
+            uint32_t bits_{0};
         };
+        static_assert(sizeof(Entry) == 12);
 
-        Entry&
-        entry(size_t id)
+        qpdf_offset_t object_end(QPDFObjGen og, bool after_space) const;
+
+        void
+        reset_ends(size_t id)
         {
-            return id < table.size() ? table[id] : table[0];
+            if (id < ends.size()) {
+                ends[id] = {};
+            }
+            large_ends.erase(id);
         }
 
         void read(qpdf_offset_t offset);
@@ -326,6 +403,36 @@ class QPDF::Objects
 
         QPDFObjectHandle read_trailer();
 
+        // Objects and trailers found while scanning the file during reconstruction.
+        struct Scan
+        {
+            struct Found
+            {
+                // Start of the line on which the object or trailer keyword was found.
+                qpdf_offset_t line;
+                bool trailer;
+                int obj;
+                int gen;
+                qpdf_offset_t offset;
+            };
+
+            std::vector<Found> found;
+            // Offsets of the first few lines scanned, used to join the scans of adjacent chunks.
+            std::vector<qpdf_offset_t> lines;
+            size_t max_lines{0};
+            // The offset at which scanning stopped.
+            qpdf_offset_t end{0};
+        };
+
+        static void scan(
+            InputSource& input,
+            QPDFTokenizer& tokenizer,
+            qpdf_offset_t start,
+            qpdf_offset_t end,
+            bool find_trailers,
+            Scan& result);
+        void scan_parallel(qpdf_offset_t eof, size_t n_threads, Scan& result);
+
         QPDFTokenizer::Token
         read_token(size_t max_len = 0)
         {
@@ -362,6 +469,18 @@ class QPDF::Objects
         std::vector<Entry> table;
         QPDFObjectHandle trailer_;
 
+        // For each uncompressed object that has been read, where the object ends before and after
+        // the white space that follows it, as distances from its offset. These are only used to
+        // check linearization hint tables, so they are kept out of the table and only grow as far
+        // as the highest object read. Ends that don't fit are kept in large_ends instead.
+        struct Ends
+        {
+            uint32_t before{0};
+            uint32_t after{0};
+        };
+        std::vector<Ends> ends;
+        std::map<size_t, std::pair<qpdf_offset_t, qpdf_offset_t>> large_ends;
+
         bool attempt_recovery_{true};
         bool initialized_{false};
         bool ignore_streams_{false};
@@ -452,6 +571,18 @@ class QPDF::Objects
     QPDFObjectHandle make_indirect(std::shared_ptr<QPDFObject> const& obj);
     std::shared_ptr<QPDFObject> get_for_parser(int id, int gen, bool parse_pdf);
     std::shared_ptr<QPDFObject> get_for_json(int id, int gen);
+    // Parse an array or dictionary whose parsing was deferred by lazy parsing.
+    std::shared_ptr<QPDFObject> parse_deferred(QPDF_Deferred const& deferred);
+    void preload_object_streams(size_t n_threads);
+
+    // Support for QPDFWriter::setReleaseWrittenObjects. start_release records which objects are
+    // still unresolved and can therefore be read again from the input without losing any changes.
+    // Until stop_release is called, release returns such an object to the unresolved state.
+    void start_release();
+    void release(QPDFObjGen og);
+    void stop_release();
+    void reset_released();
+    bool is_stream(QPDFObjectHandle& oh);
 
     // Get a list of objects that would be permitted in an object stream.
     template <typename T>
@@ -478,7 +609,8 @@ class QPDF::Objects
     bool cached(QPDFObjGen og);
     bool unresolved(QPDFObjGen og);
 
-    QPDFObjectHandle readObjectInStream(std::shared_ptr<InputSource>& input, int obj);
+    QPDFObjectHandle readObjectInStream(
+        std::shared_ptr<InputSource>& input, std::shared_ptr<Buffer> const& data, int obj);
     void resolveObjectsInStream(int obj_stream_number);
     QPDFObjectHandle read_object(std::string const& description, QPDFObjGen og);
     void read_stream(QPDFObjectHandle& object, QPDFObjGen og, qpdf_offset_t offset);
@@ -492,6 +624,17 @@ class QPDF::Objects
     Xref_table xref;
 
     std::map<QPDFObjGen, Entry> table;
+    // Decoded data of object streams waiting to be used by resolveObjectsInStream.
+    std::map<int, std::shared_ptr<Buffer>> preloaded;
+    // Indexed by object id. Objects that may be released, objects that have been released since
+    // they were last needed, and objects that have ever been released. resolveObjectsInStream
+    // doesn't read released objects along with the object it is resolving so that they don't stay
+    // in memory.
+    std::vector<bool> releasable;
+    std::vector<bool> released;
+    std::vector<bool> was_released;
+    // Objects with this id or higher have been created since start_release was called.
+    int first_new_id{0};
 }; // Objects
 
 #endif // QPDF_OBJECTS_HH
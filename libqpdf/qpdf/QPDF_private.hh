@@ -50,6 +50,33 @@ class QPDF::ParseGuard
     QPDF* qpdf;
 };
 
+// DeferredInput holds what is needed to parse the arrays and dictionaries whose parsing was
+// deferred while reading one object with lazy parsing enabled. It is shared by all of them.
+class QPDF::DeferredInput
+{
+  public:
+    DeferredInput(
+        QPDF& qpdf,
+        std::shared_ptr<Buffer> data,
+        std::string input_name,
+        QPDFObjGen og,
+        std::string description) :
+        m(qpdf.m),
+        data(std::move(data)),
+        input_name(std::move(input_name)),
+        og(og),
+        description(std::move(description))
+    {
+    }
+
+    std::weak_ptr<Members> m;
+    // The data of the object stream containing the object, or null if it was read from the file.
+    std::shared_ptr<Buffer> data;
+    std::string input_name;
+    QPDFObjGen og;
+    std::string description;
+};
+
 // Pipe class is restricted to QPDF_Stream.
 class QPDF::Pipe
 {
@@ -311,11 +338,157 @@ class QPDF::ObjUser
     std::string key; // if ou_trailer_key or ou_root_key
 };
 
+// The objects used by each object user and the object users of each object, as computed by
+// optimize(). While the maps are being built, each use is recorded as a pair of user index and
+// object. finish() sorts and de-duplicates the pairs into two compressed adjacency lists, one
+// listing the objects of each user in object order and one listing the users of each object, so
+// building the maps needs no per-node allocations.
+class QPDF::ObjUserMap
+{
+  public:
+    // Return the index of ou, adding it if needed.
+    size_t add_user(ObjUser const& ou);
+
+    ObjUser const&
+    user(size_t index) const
+    {
+        return users.at(index);
+    }
+
+    void
+    add(size_t user, QPDFObjGen og)
+    {
+        uses.emplace_back(user, og);
+    }
+
+    // Start a traversal of the object tree. visit(og) returns false if og has already been visited
+    // since the last call to start_traversal.
+    void
+    start_traversal()
+    {
+        ++traversal;
+        visited_other.clear();
+    }
+
+    bool
+    visit(QPDFObjGen og)
+    {
+        auto id = static_cast<size_t>(og.getObj());
+        if (id >= visited.size()) {
+            visited.resize(id + 1);
+        }
+        auto& v = visited[id];
+        if (v.first != traversal) {
+            v = {traversal, og.getGen()};
+            return true;
+        }
+        // Only damaged files have objects with the same number but different generations.
+        return v.second != og.getGen() && visited_other.add(og);
+    }
+
+    // Call fn with a reference to the object of every use so it can replace it. Uses for which fn
+    // returns false are dropped. This must be called before finish().
+    template <typename F>
+    void
+    replace_objects(F fn)
+    {
+        size_t kept = 0;
+        for (auto& use: uses) {
+            if (fn(use.second)) {
+                uses[kept++] = use;
+            }
+        }
+        uses.resize(kept);
+    }
+
+    void finish();
+
+    bool
+    empty() const noexcept
+    {
+        return objects_.empty();
+    }
+
+    // A sequence of elements of a vector.
+    template <typename T>
+    class Range
+    {
+      public:
+        Range(T const* begin, T const* end) :
+            begin_(begin),
+            end_(end)
+        {
+        }
+        T const*
+        begin() const noexcept
+        {
+            return begin_;
+        }
+        T const*
+        end() const noexcept
+        {
+            return end_;
+        }
+        size_t
+        size() const noexcept
+        {
+            return static_cast<size_t>(end_ - begin_);
+        }
+        bool
+        empty() const noexcept
+        {
+            return begin_ == end_;
+        }
+
+      private:
+        T const* begin_;
+        T const* end_;
+    };
+
+    // The objects used by ou in order of object. The result is empty if ou uses no objects.
+    Range<QPDFObjGen> objects_of(ObjUser const& ou) const;
+
+    // All objects that have users, in order.
+    std::vector<QPDFObjGen> const&
+    objects() const noexcept
+    {
+        return objects_;
+    }
+
+    // The indices of the users of the object at index i of objects().
+    Range<size_t>
+    users_of(size_t i) const
+    {
+        return {object_users.data() + object_start[i], object_users.data() + object_start[i + 1]};
+    }
+
+    // The number of users of og.
+    size_t user_count(QPDFObjGen og) const;
+
+  private:
+    std::vector<ObjUser> users;
+    std::map<ObjUser, size_t> user_index;
+    std::vector<std::pair<size_t, QPDFObjGen>> uses;
+    // For each object number, the last traversal that visited it and the generation visited.
+    std::vector<std::pair<size_t, int>> visited;
+    QPDFObjGen::set visited_other;
+    size_t traversal{0};
+
+    // Objects of user i are user_objects[user_start[i]] up to user_objects[user_start[i + 1]].
+    std::vector<size_t> user_start;
+    std::vector<QPDFObjGen> user_objects;
+    // Users of objects_[i] are object_users[object_start[i]] up to object_users[object_start[i +
+    // 1]].
+    std::vector<QPDFObjGen> objects_;
+    std::vector<size_t> object_start;
+    std::vector<size_t> object_users;
+};
+
 struct QPDF::UpdateObjectMapsFrame
 {
-    UpdateObjectMapsFrame(ObjUser const& ou, QPDFObjectHandle oh, bool top);
+    UpdateObjectMapsFrame(size_t ou, QPDFObjectHandle oh, bool top);
 
-    ObjUser const& ou;
+    size_t ou;
     QPDFObjectHandle oh;
     bool top;
 };
@@ -367,6 +540,9 @@ class QPDF::Members
     size_t max_warnings{0};
     bool attempt_recovery{true};
     bool check_mode{false};
+    bool use_mmap{false};
+    bool lazy_parsing{false};
+    int recovery_threads{1};
     std::shared_ptr<EncryptionParameters> encp;
     std::string pdf_version;
     Objects objects;
@@ -386,6 +562,9 @@ class QPDF::Members
     bool immediate_copy_from{false};
     bool in_parse{false};
     std::set<int> resolved_object_streams;
+    // Set while objects that QPDFWriter has released are read again. Any warnings about them were
+    // issued when they were first read.
+    bool mute_warnings{false};
 
     // Linearization data
     bool linearization_warnings{false};
@@ -414,8 +593,7 @@ class QPDF::Members
     std::vector<QPDFObjectHandle> part9;
 
     // Optimization data
-    std::map<ObjUser, std::set<QPDFObjGen>> obj_user_to_objects;
-    std::map<QPDFObjGen, std::set<ObjUser>> object_to_obj_users;
+    ObjUserMap obj_user_map;
 };
 
 inline QPDF::Objects&
@@ -435,7 +613,6 @@ QPDF::objects() const noexcept
 class QPDF::Resolver
 {
     friend class QPDFObject;
-    friend class QPDF_Unresolved;
 
   private:
     static QPDFObject*
@@ -443,6 +620,9 @@ class QPDF::Resolver
     {
         return qpdf->m->objects.resolve(og);
     }
+    // Return the parsed contents of a deferred array or dictionary, or nullptr if they can't be
+    // parsed because the QPDF has been destroyed.
+    static std::shared_ptr<QPDFObject> parsed(QPDF_Deferred const& deferred);
 };
 
 // JobSetter class is restricted to QPDFJob.
@@ -518,6 +698,19 @@ class QPDF::Writer
         return qpdf.generateHintStream(new_obj, obj, hint_stream, S, O, compressed);
     }
 
+    static bool
+    getRawStreamDataRange(
+        QPDF& qpdf, QPDFObjectHandle& stream, qpdf_offset_t& offset, size_t& length)
+    {
+        return qpdf.getRawStreamDataRange(stream, offset, length);
+    }
+
+    static void
+    pipeRawStreamData(QPDF& qpdf, qpdf_offset_t offset, size_t length, Pipeline* pipeline)
+    {
+        QPDF::pipeRawStreamData(*qpdf.m->file, offset, length, pipeline);
+    }
+
     static std::vector<QPDFObjGen>
     getCompressibleObjGens(QPDF& qpdf)
     {
@@ -541,6 +734,30 @@ class QPDF::Writer
     {
         return qpdf.objects().table_size();
     }
+
+    static void
+    startRelease(QPDF& qpdf)
+    {
+        qpdf.objects().start_release();
+    }
+
+    static void
+    release(QPDF& qpdf, QPDFObjGen og)
+    {
+        qpdf.objects().release(og);
+    }
+
+    static void
+    stopRelease(QPDF& qpdf)
+    {
+        qpdf.objects().stop_release();
+    }
+
+    static bool
+    isStream(QPDF& qpdf, QPDFObjectHandle& oh)
+    {
+        return qpdf.objects().is_stream(oh);
+    }
 };
 
 #endif // QPDF_PRIVATE_HH
@@ -0,0 +1,46 @@
+#ifndef WORKERPOOL_HH
+#define WORKERPOOL_HH
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed-size pool of worker threads for offloading self-contained work, such as compressing a
+// buffer, from the thread that owns a QPDF object. QPDF, QPDFObjectHandle and InputSource objects
+// are not thread-safe, so tasks must only operate on data that has been handed to them. Any
+// exception thrown by a task is delivered through the std::future returned by submit.
+//
+// Destroying the pool discards tasks that have not started and waits for running tasks to finish.
+// Futures for discarded tasks report std::future_error (broken promise).
+class WorkerPool
+{
+  public:
+    WorkerPool(size_t n_threads);
+    ~WorkerPool();
+    WorkerPool(WorkerPool const&) = delete;
+    WorkerPool& operator=(WorkerPool const&) = delete;
+
+    size_t
+    size() const noexcept
+    {
+        return threads.size();
+    }
+
+    std::future<void> submit(std::function<void()> task);
+
+  private:
+    void run();
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::packaged_task<void()>> queue;
+    std::vector<std::thread> threads;
+    bool stopping{false};
+};
+
+#endif // WORKERPOOL_HH
@@ -120,6 +120,40 @@ ap.addOptionHelp("--keep-files-open-threshold", "general", "set threshold for --
 Set the threshold used by --keep-files-open, overriding the
 default value of 200.
 )");
+ap.addOptionHelp("--mmap", "general", "map input files into memory", R"(--mmap
+
+Map input files into memory instead of reading them through
+the standard I/O library. This can make processing large
+files faster, especially with options that read the input
+many times. If a file can't be mapped, it is read normally.
+Input files must not be modified while qpdf is running.
+)");
+ap.addOptionHelp("--recovery-threads", "general", "scan damaged files using the given number of threads", R"(--recovery-threads=count
+
+When reconstructing the cross-reference table of a damaged
+file, scan the file for objects using the given number of
+threads. This only has an effect on large files that are read
+with --mmap. The results are the same as with a single thread.
+)");
+ap.addOptionHelp("--preload-object-streams", "general", "preload object streams using the given number of threads", R"(--preload-object-streams=threads
+
+Load all objects stored in object streams in the input file
+right after opening it, decompressing the object streams using
+the given number of threads. This can make processing faster
+for large files that store most of their objects in object
+streams when the whole file is going to be read, as when
+writing it.
+)");
+ap.addOptionHelp("--lazy-parsing", "general", "parse large arrays and dictionaries when they are used", R"(--lazy-parsing
+
+Don't parse the contents of large arrays and dictionaries
+within objects read from input files until they are used. This
+makes operations that only look at a small part of a large
+file, such as --show-npages, faster, but it makes operations
+that read the whole file, such as writing it, slower. Problems
+with the contents of such arrays and dictionaries are reported
+when they are used.
+)");
 ap.addHelpTopic("advanced-control", "tweak qpdf's behavior", R"(Advanced control options control qpdf's behavior in ways that would
 normally never be needed by a user but that may be useful to
 developers or people investigating problems with specific files.
@@ -234,6 +268,15 @@ gzip), which is the default compression for most PDF files.
 You need --recompress-flate with this option if you want to
 change already compressed streams.
 )");
+ap.addOptionHelp("--compression-threads", "transformation", "set number of threads for compression", R"(--compression-threads=count
+
+Use the given number of worker threads to compress stream data
+with flate while the output file is being written. Stream data
+is still read and decoded in order, and the output is identical
+to what is written without this option. This is most useful with
+--recompress-flate on files with many large streams. A value of
+0 or 1 disables worker threads.
+)");
 ap.addOptionHelp("--normalize-content", "transformation", "fix newlines in content streams", R"(--normalize-content=[y|n]
 
 Normalize newlines to UNIX-style newlines in PDF content
@@ -261,6 +304,40 @@ ap.addOptionHelp("--preserve-unreferenced-resources", "transformation", "use --r
 ap.addOptionHelp("--newline-before-endstream", "transformation", "force a newline before endstream", R"(For an extra newline before endstream. Using this option enables
 qpdf to preserve PDF/A when rewriting such files.
 )");
+ap.addOptionHelp("--indirect-stream-lengths", "transformation", "write stream lengths as separate objects", R"(--indirect-stream-lengths
+
+Write the length of each stream as a separate object after the
+stream instead of directly in the stream dictionary. This
+allows qpdf to write stream data that it doesn't have to
+decode directly to the output without first holding it in
+memory, which reduces memory use when writing large streams,
+at the cost of one extra object per stream. This option is
+ignored with --linearize.
+)");
+ap.addOptionHelp("--release-written-objects", "transformation", "free objects after writing them", R"(--release-written-objects
+
+Free objects from the input file from memory once they have
+been written and read them again if they are needed later.
+This keeps memory use low when rewriting large files at the
+cost of some extra time, particularly for files with object
+streams. This option is ignored with --linearize.
+)");
+ap.addOptionHelp("--linearization-cache-size", "transformation", "keep first-pass linearization data in memory", R"(--linearization-cache-size=size
+
+When writing linearized output, keep up to this many bytes of
+filtered stream data and object stream contents computed in the
+first pass in memory and reuse them in the second pass instead
+of computing them again. This makes linearizing faster,
+especially when streams are compressed, at the cost of up to
+this much extra memory. The default is 0.
+)");
+ap.addOptionHelp("--linearization-cache-file", "transformation", "keep first-pass linearization data in a file", R"(--linearization-cache-file
+
+When writing linearized output, write data from the first pass
+that doesn't fit in the memory allowed by
+--linearization-cache-size to a temporary file and read it back
+in the second pass instead of computing it again.
+)");
 ap.addOptionHelp("--coalesce-contents", "transformation", "combine content streams", R"(If a page has an array of content streams, concatenate them into
 a single content stream.
 )");
@@ -355,6 +432,15 @@ File names are generated from the specified output file as follows:
 Page ranges are single page numbers for single-page groups or first-last
 for multi-page groups.
 )");
+ap.addOptionHelp("--jobs", "modification", "write split output files in parallel", R"(--jobs=n
+
+When used with --split-pages, write up to n output files at the
+same time. Pages are still extracted from the input one group at a
+time, but the output files are written in parallel. Stream data
+from the input is kept in memory, so this uses more memory. The
+resulting files are the same as when --jobs is not given.
+--jobs is ignored with --progress or --linearize-pass1.
+)");
 ap.addOptionHelp("--overlay", "modification", "begin overlay options", R"(--overlay file [options] --
 
 Overlay pages from another file on the output.
@@ -1010,6 +1096,10 @@ for debugging qpdf.
 ap.addOptionHelp("--test-json-schema", "testing", "test generated json against schema", R"(This is used by qpdf's test suite to check consistency between
 the output of qpdf --json and the output of qpdf --json-help.
 )");
+ap.addOptionHelp("--report-linearization-times", "testing", "report time taken by each phase of linearization", R"(When writing linearized output, report how many seconds each
+phase of writing took. This is used to find out where the time
+goes when linearizing large files.
+)");
 ap.addOptionHelp("--report-memory-usage", "testing", "best effort report of memory usage", R"(This is used by qpdf's performance test suite to report the
 maximum amount of memory used in supported environments.
 )");
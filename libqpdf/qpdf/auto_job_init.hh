@@ -50,11 +50,15 @@ this->ap.addBare("filtered-stream-data", [this](){c_main->filteredStreamData();}
 this->ap.addBare("flatten-rotation", [this](){c_main->flattenRotation();});
 this->ap.addBare("generate-appearances", [this](){c_main->generateAppearances();});
 this->ap.addBare("ignore-xref-streams", [this](){c_main->ignoreXrefStreams();});
+this->ap.addBare("indirect-stream-lengths", [this](){c_main->indirectStreamLengths();});
 this->ap.addBare("is-encrypted", [this](){c_main->isEncrypted();});
 this->ap.addBare("json-input", [this](){c_main->jsonInput();});
 this->ap.addBare("keep-inline-images", [this](){c_main->keepInlineImages();});
+this->ap.addBare("lazy-parsing", [this](){c_main->lazyParsing();});
+this->ap.addBare("linearization-cache-file", [this](){c_main->linearizationCacheFile();});
 this->ap.addBare("linearize", [this](){c_main->linearize();});
 this->ap.addBare("list-attachments", [this](){c_main->listAttachments();});
+this->ap.addBare("mmap", [this](){c_main->mmap();});
 this->ap.addBare("newline-before-endstream", [this](){c_main->newlineBeforeEndstream();});
 this->ap.addBare("no-original-object-ids", [this](){c_main->noOriginalObjectIds();});
 this->ap.addBare("no-warn", [this](){c_main->noWarn();});
@@ -68,10 +72,12 @@ this->ap.addBare("progress", [this](){c_main->progress();});
 this->ap.addBare("qdf", [this](){c_main->qdf();});
 this->ap.addBare("raw-stream-data", [this](){c_main->rawStreamData();});
 this->ap.addBare("recompress-flate", [this](){c_main->recompressFlate();});
+this->ap.addBare("release-written-objects", [this](){c_main->releaseWrittenObjects();});
 this->ap.addBare("remove-info", [this](){c_main->removeInfo();});
 this->ap.addBare("remove-metadata", [this](){c_main->removeMetadata();});
 this->ap.addBare("remove-page-labels", [this](){c_main->removePageLabels();});
 this->ap.addBare("replace-input", b(&ArgParser::argReplaceInput));
+this->ap.addBare("report-linearization-times", [this](){c_main->reportLinearizationTimes();});
 this->ap.addBare("report-memory-usage", [this](){c_main->reportMemoryUsage();});
 this->ap.addBare("requires-password", [this](){c_main->requiresPassword();});
 this->ap.addBare("remove-restrictions", [this](){c_main->removeRestrictions();});
@@ -92,13 +98,16 @@ this->ap.addBare("verbose", [this](){c_main->verbose();});
 this->ap.addBare("warning-exit-0", [this](){c_main->warningExit0();});
 this->ap.addBare("with-images", [this](){c_main->withImages();});
 this->ap.addRequiredParameter("compression-level", [this](std::string const& x){c_main->compressionLevel(x);}, "level");
+this->ap.addRequiredParameter("compression-threads", [this](std::string const& x){c_main->compressionThreads(x);}, "count");
 this->ap.addRequiredParameter("copy-encryption", [this](std::string const& x){c_main->copyEncryption(x);}, "file");
 this->ap.addRequiredParameter("encryption-file-password", [this](std::string const& x){c_main->encryptionFilePassword(x);}, "password");
 this->ap.addRequiredParameter("force-version", [this](std::string const& x){c_main->forceVersion(x);}, "version");
 this->ap.addRequiredParameter("ii-min-bytes", [this](std::string const& x){c_main->iiMinBytes(x);}, "minimum");
 this->ap.addRequiredParameter("job-json-file", [this](std::string const& x){c_main->jobJsonFile(x);}, "file");
+this->ap.addRequiredParameter("jobs", [this](std::string const& x){c_main->jobs(x);}, "n");
 this->ap.addRequiredParameter("json-object", [this](std::string const& x){c_main->jsonObject(x);}, "trailer");
 this->ap.addRequiredParameter("keep-files-open-threshold", [this](std::string const& x){c_main->keepFilesOpenThreshold(x);}, "count");
+this->ap.addRequiredParameter("linearization-cache-size", [this](std::string const& x){c_main->linearizationCacheSize(x);}, "size");
 this->ap.addRequiredParameter("linearize-pass1", [this](std::string const& x){c_main->linearizePass1(x);}, "filename");
 this->ap.addRequiredParameter("min-version", [this](std::string const& x){c_main->minVersion(x);}, "version");
 this->ap.addRequiredParameter("oi-min-area", [this](std::string const& x){c_main->oiMinArea(x);}, "minimum");
@@ -106,6 +115,8 @@ this->ap.addRequiredParameter("oi-min-height", [this](std::string const& x){c_ma
 this->ap.addRequiredParameter("oi-min-width", [this](std::string const& x){c_main->oiMinWidth(x);}, "minimum");
 this->ap.addRequiredParameter("password", [this](std::string const& x){c_main->password(x);}, "password");
 this->ap.addRequiredParameter("password-file", [this](std::string const& x){c_main->passwordFile(x);}, "password");
+this->ap.addRequiredParameter("preload-object-streams", [this](std::string const& x){c_main->preloadObjectStreams(x);}, "threads");
+this->ap.addRequiredParameter("recovery-threads", [this](std::string const& x){c_main->recoveryThreads(x);}, "count");
 this->ap.addRequiredParameter("remove-attachment", [this](std::string const& x){c_main->removeAttachment(x);}, "attachment");
 this->ap.addRequiredParameter("rotate", [this](std::string const& x){c_main->rotate(x);}, "[+|-]angle");
 this->ap.addRequiredParameter("show-attachment", [this](std::string const& x){c_main->showAttachment(x);}, "attachment");
@@ -50,6 +50,18 @@ popHandler(); // key: preserveUnreferenced
 pushKey("newlineBeforeEndstream");
 addBare([this]() { c_main->newlineBeforeEndstream(); });
 popHandler(); // key: newlineBeforeEndstream
+pushKey("indirectStreamLengths");
+addBare([this]() { c_main->indirectStreamLengths(); });
+popHandler(); // key: indirectStreamLengths
+pushKey("releaseWrittenObjects");
+addBare([this]() { c_main->releaseWrittenObjects(); });
+popHandler(); // key: releaseWrittenObjects
+pushKey("linearizationCacheSize");
+addParameter([this](std::string const& p) { c_main->linearizationCacheSize(p); });
+popHandler(); // key: linearizationCacheSize
+pushKey("linearizationCacheFile");
+addBare([this]() { c_main->linearizationCacheFile(); });
+popHandler(); // key: linearizationCacheFile
 pushKey("normalizeContent");
 addChoices(yn_choices, true, [this](std::string const& p) { c_main->normalizeContent(p); });
 popHandler(); // key: normalizeContent
@@ -107,6 +119,9 @@ popHandler(); // key: progress
 pushKey("splitPages");
 addParameter([this](std::string const& p) { c_main->splitPages(p); });
 popHandler(); // key: splitPages
+pushKey("jobs");
+addParameter([this](std::string const& p) { c_main->jobs(p); });
+popHandler(); // key: jobs
 pushKey("jsonOutput");
 addChoices(json_output_choices, false, [this](std::string const& p) { c_main->jsonOutput(p); });
 popHandler(); // key: jsonOutput
@@ -284,6 +299,18 @@ popHandler(); // key: keepFilesOpen
 pushKey("keepFilesOpenThreshold");
 addParameter([this](std::string const& p) { c_main->keepFilesOpenThreshold(p); });
 popHandler(); // key: keepFilesOpenThreshold
+pushKey("mmap");
+addBare([this]() { c_main->mmap(); });
+popHandler(); // key: mmap
+pushKey("recoveryThreads");
+addParameter([this](std::string const& p) { c_main->recoveryThreads(p); });
+popHandler(); // key: recoveryThreads
+pushKey("preloadObjectStreams");
+addParameter([this](std::string const& p) { c_main->preloadObjectStreams(p); });
+popHandler(); // key: preloadObjectStreams
+pushKey("lazyParsing");
+addBare([this]() { c_main->lazyParsing(); });
+popHandler(); // key: lazyParsing
 pushKey("noWarn");
 addBare([this]() { c_main->noWarn(); });
 popHandler(); // key: noWarn
@@ -314,6 +341,9 @@ popHandler(); // key: coalesceContents
 pushKey("compressionLevel");
 addParameter([this](std::string const& p) { c_main->compressionLevel(p); });
 popHandler(); // key: compressionLevel
+pushKey("compressionThreads");
+addParameter([this](std::string const& p) { c_main->compressionThreads(p); });
+popHandler(); // key: compressionThreads
 pushKey("externalizeInlineImages");
 addBare([this]() { c_main->externalizeInlineImages(); });
 popHandler(); // key: externalizeInlineImages
@@ -421,6 +451,9 @@ popHandler(); // key: removeMetadata
 pushKey("removePageLabels");
 addBare([this]() { c_main->removePageLabels(); });
 popHandler(); // key: removePageLabels
+pushKey("reportLinearizationTimes");
+addBare([this]() { c_main->reportLinearizationTimes(); });
+popHandler(); // key: reportLinearizationTimes
 pushKey("reportMemoryUsage");
 addBare([this]() { c_main->reportMemoryUsage(); });
 popHandler(); // key: reportMemoryUsage
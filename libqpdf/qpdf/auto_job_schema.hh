@@ -9,6 +9,10 @@ static constexpr char const* JOB_SCHEMA_DATA = R"({
   "qdf": "enable viewing PDF code in a text editor",
   "preserveUnreferenced": "preserve unreferenced objects",
   "newlineBeforeEndstream": "force a newline before endstream",
+  "indirectStreamLengths": "write stream lengths as separate objects",
+  "releaseWrittenObjects": "free objects after writing them",
+  "linearizationCacheSize": "keep first-pass linearization data in memory",
+  "linearizationCacheFile": "keep first-pass linearization data in a file",
   "normalizeContent": "fix newlines in content streams",
   "streamData": "control stream compression",
   "compressStreams": "compress uncompressed streams",
@@ -28,6 +32,7 @@ static constexpr char const* JOB_SCHEMA_DATA = R"({
   "forceVersion": "set output PDF version",
   "progress": "show progress when writing",
   "splitPages": "write pages to separate files",
+  "jobs": "write split output files in parallel",
   "jsonOutput": "apply defaults for JSON serialization",
   "removeRestrictions": "remove security restrictions from input file",
   "encrypt": {
@@ -94,6 +99,10 @@ static constexpr char const* JOB_SCHEMA_DATA = R"({
   "allowWeakCrypto": "allow insecure cryptographic algorithms",
   "keepFilesOpen": "manage keeping multiple files open",
   "keepFilesOpenThreshold": "set threshold for keepFilesOpen",
+  "mmap": "map input files into memory",
+  "recoveryThreads": "scan damaged files using the given number of threads",
+  "preloadObjectStreams": "preload object streams using the given number of threads",
+  "lazyParsing": "parse large arrays and dictionaries when they are used",
   "noWarn": "suppress printing of warning messages",
   "verbose": "print additional information",
   "testJsonSchema": "test generated json against schema",
@@ -104,6 +113,7 @@ static constexpr char const* JOB_SCHEMA_DATA = R"({
   "suppressRecovery": "suppress error recovery",
   "coalesceContents": "combine content streams",
   "compressionLevel": "set compression level for flate",
+  "compressionThreads": "set number of threads for compression",
   "externalizeInlineImages": "convert inline to regular images",
   "iiMinBytes": "set minimum size for externalizeInlineImages",
   "removeUnreferencedResources": "remove unreferenced page resources",
@@ -148,6 +158,7 @@ static constexpr char const* JOB_SCHEMA_DATA = R"({
   "removeInfo": "remove file information",
   "removeMetadata": "remove metadata",
   "removePageLabels": "remove explicit page numbers",
+  "reportLinearizationTimes": "report time taken by each phase of linearization",
   "reportMemoryUsage": "best effort report of memory usage",
   "rotate": "rotate pages",
   "setPageLabels": [
@@ -0,0 +1,80 @@
+#ifndef HEX_FUNCTIONS_HH
+#define HEX_FUNCTIONS_HH
+
+#include <qpdf/QUtil.hh>
+#include <qpdf/sse2.hh>
+
+#include <cstddef>
+
+// These functions convert runs of bytes to and from hexadecimal for QUtil and Pl_ASCIIHexDecoder.
+// With SSE2, they handle 16 bytes at a time.
+
+// Write the two lower-case hexadecimal digits for each of the n bytes at in to out.
+inline void
+hex_encode_block(unsigned char const* in, size_t n, char* out)
+{
+    static auto constexpr hexchars = "0123456789abcdef";
+    size_t i = 0;
+#ifdef QPDF_SSE2
+    auto const low_nibble = _mm_set1_epi8(0x0f);
+    auto const nine = _mm_set1_epi8(9);
+    // Digits above 9 are 'a' - '0' - 10 further along.
+    auto const letter_offset = _mm_set1_epi8('a' - '0' - 10);
+    auto const zero = _mm_set1_epi8('0');
+    auto to_digits = [&](__m128i v) {
+        return _mm_add_epi8(
+            _mm_add_epi8(v, zero), _mm_and_si128(_mm_cmpgt_epi8(v, nine), letter_offset));
+    };
+    for (; i + 16 <= n; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+        auto high = to_digits(_mm_and_si128(_mm_srli_epi16(v, 4), low_nibble));
+        auto low = to_digits(_mm_and_si128(v, low_nibble));
+        auto p = reinterpret_cast<__m128i*>(out + 2 * i);
+        _mm_storeu_si128(p, _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(p + 1, _mm_unpackhi_epi8(high, low));
+    }
+#endif
+    for (; i < n; ++i) {
+        out[2 * i] = hexchars[in[i] >> 4];
+        out[2 * i + 1] = hexchars[in[i] & 0x0f];
+    }
+}
+
+// Decode pairs of hexadecimal digits from the n characters at in to out, stopping at the first pair
+// that contains anything else. Return the number of characters decoded, which is always even.
+inline size_t
+hex_decode_block(unsigned char const* in, size_t n, unsigned char* out)
+{
+    size_t i = 0;
+#ifdef QPDF_SSE2
+    for (; i + 16 <= n; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+        auto digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+        auto is_digit = in_range_epu8(digit, 9);
+        auto letter = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        auto is_letter = in_range_epu8(letter, 5);
+        if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff) {
+            break;
+        }
+        auto nibbles = _mm_or_si128(
+            _mm_and_si128(is_digit, digit),
+            _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+        // Each 16-bit lane has the high nibble in its low byte and the low nibble in its high byte.
+        auto bytes = _mm_or_si128(
+            _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0xff)), 4),
+            _mm_srli_epi16(nibbles, 8));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i / 2), _mm_packus_epi16(bytes, bytes));
+    }
+#endif
+    for (; i + 2 <= n; i += 2) {
+        auto high = QUtil::hex_decode_char(static_cast<char>(in[i]));
+        auto low = QUtil::hex_decode_char(static_cast<char>(in[i + 1]));
+        if ((high | low) >= '\20') {
+            break;
+        }
+        out[i / 2] = static_cast<unsigned char>((high << 4) | low);
+    }
+    return i;
+}
+
+#endif // HEX_FUNCTIONS_HH
@@ -0,0 +1,20 @@
+#ifndef SSE2_HH
+#define SSE2_HH
+
+// Code that has an SSE2 version includes this file and checks QPDF_SSE2. SSE2 is always available
+// on x86-64 and is enabled on 32-bit x86 by compiler options.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define QPDF_SSE2
+
+// Return a mask of the bytes of v that are no greater than limit as unsigned values. Byte
+// comparisons are signed, so this uses the unsigned minimum instead.
+inline __m128i
+in_range_epu8(__m128i v, char limit)
+{
+    return _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(limit)), v);
+}
+#endif
+
+#endif // SSE2_HH
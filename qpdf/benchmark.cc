@@ -0,0 +1,713 @@
+#include "test_helpers.hh"
+
+#include <qpdf/Buffer.hh>
+#include <qpdf/BufferInputSource.hh>
+#include <qpdf/FileInputSource.hh>
+#include <qpdf/JSON.hh>
+#include <qpdf/MmapInputSource.hh>
+#include <qpdf/Pl_Flate.hh>
+#include <qpdf/Pl_String.hh>
+#include <qpdf/QIntC.hh>
+#include <qpdf/QPDF.hh>
+#include <qpdf/QPDFObjectHandle.hh>
+#include <qpdf/QPDFTokenizer.hh>
+#include <qpdf/QPDFWriter.hh>
+#include <qpdf/QUtil.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+// This program measures how long various operations take. It is not run by the test suite. Each
+// mode reports the fastest of several runs of each operation it measures. Operations that produce
+// data check it against the expected result so that the numbers are not for broken code.
+
+using namespace test_helpers;
+
+static char const* whoami = nullptr;
+
+static void
+usage()
+{
+    std::cerr << "Usage: " << whoami << " find FILE [MEGABYTES]" << std::endl
+              << "       " << whoami << " tokenizer [MEGABYTES]" << std::endl
+              << "       " << whoami << " rewrite FILE" << std::endl
+              << "       " << whoami << " open FILE" << std::endl
+              << "       " << whoami << " linearize FILE" << std::endl
+              << "       " << whoami << " png-predictor [MEGABYTES]" << std::endl
+              << "       " << whoami << " tiff-predictor [MEGABYTES]" << std::endl
+              << "       " << whoami << " lzw [MEGABYTES]" << std::endl
+              << "       " << whoami << " codecs [MEGABYTES]" << std::endl
+              << "       " << whoami << " flate [MEGABYTES]" << std::endl;
+    exit(2);
+}
+
+static void
+check(bool ok)
+{
+    if (!ok) {
+        std::cerr << whoami << ": wrong result" << std::endl;
+        exit(2);
+    }
+}
+
+// Return the shortest time in seconds taken by fn in several runs.
+static double
+best_time(std::function<void()> fn, int runs = 5)
+{
+    std::chrono::duration<double> best{1e9};
+    for (int i = 0; i < runs; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        best =
+            std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start));
+    }
+    return best.count();
+}
+
+namespace
+{
+    class CountObjects: public QPDFObjectHandle::ParserCallbacks
+    {
+      public:
+        ~CountObjects() override = default;
+        void
+        handleObject(QPDFObjectHandle) override
+        {
+            ++count;
+        }
+        void
+        handleEOF() override
+        {
+        }
+
+        size_t count{0};
+    };
+
+    // Accept a match only if it is the endstream keyword, as QPDF::findEndstream does.
+    class EndstreamFinder: public InputSource::Finder
+    {
+      public:
+        EndstreamFinder(InputSource& is) :
+            is(is)
+        {
+        }
+        ~EndstreamFinder() override = default;
+
+        bool
+        check() override
+        {
+            char buf[9];
+            return is.read(buf, 9) == 9 && memcmp(buf, "endstream", 9) == 0;
+        }
+
+      private:
+        InputSource& is;
+    };
+} // namespace
+
+// Write content-stream-like data followed by "endstream" to filename and find it with each kind of
+// input source, both as findEndstream does, by searching for "end", and by searching for
+// "endstream".
+static void
+find(char const* filename, size_t megabytes)
+{
+    {
+        auto block = content_stream(1U << 20);
+        block.resize(1U << 20);
+        QUtil::FileCloser fc(QUtil::safe_fopen(filename, "wb"));
+        for (size_t i = 0; i < megabytes; ++i) {
+            fwrite(block.data(), 1, block.size(), fc.f);
+        }
+        fputs("\nendstream\n", fc.f);
+    }
+
+    auto run = [megabytes](InputSource& is, char const* name) {
+        for (char const* needle: {"end", "endstream"}) {
+            auto seconds = best_time([&]() {
+                EndstreamFinder f(is);
+                check(is.findFirst(needle, 0, 0, f));
+            });
+            std::cout << name << " \"" << needle << "\": " << seconds << " s, "
+                      << (static_cast<double>(megabytes) / seconds) << " MB/s" << std::endl;
+        }
+    };
+    FileInputSource fis(filename);
+    run(fis, "file");
+    MmapInputSource mis(filename);
+    run(mis, "mmap");
+}
+
+// Tokenize and parse content-stream-like data.
+static void
+tokenizer(size_t megabytes)
+{
+    auto data = content_stream(megabytes << 20);
+    auto report = [megabytes](char const* what, size_t count, double seconds) {
+        std::cout << what << ": " << count << " in " << seconds << " s, "
+                  << (static_cast<double>(megabytes) / seconds) << " MB/s" << std::endl;
+    };
+
+    size_t tokens = 0;
+    auto seconds = best_time([&]() {
+        BufferInputSource is("benchmark", data);
+        QPDFTokenizer tok;
+        tok.allowEOF();
+        tokens = 0;
+        while (tok.readToken(is, "benchmark").getType() != QPDFTokenizer::tt_eof) {
+            ++tokens;
+        }
+    });
+    report("tokens", tokens, seconds);
+
+    QPDF qpdf;
+    qpdf.emptyPDF();
+    auto stream = qpdf.newStream(data);
+    CountObjects objects;
+    seconds = best_time([&]() {
+        objects.count = 0;
+        QPDFObjectHandle::parseContentStream(stream, &objects);
+    });
+    report("objects", objects.count, seconds);
+}
+
+// Open filename and look up every key of all of its dictionaries, and separately open filename and write
+// it with object streams preserved and with object streams generated. Files with many
+// dictionaries show how long loading and writing dictionaries takes.
+static void
+rewrite(char const* filename)
+{
+    auto open = [filename]() {
+        auto pdf = std::make_unique<QPDF>();
+        pdf->setSuppressWarnings(true);
+        pdf->processFile(filename);
+        return pdf;
+    };
+
+    size_t keys = 0;
+    auto load = best_time([&]() {
+        auto pdf = open();
+        keys = 0;
+        for (auto& obj: pdf->getAllObjects()) {
+            auto dict = obj.isStream() ? obj.getDict() : obj;
+            if (dict.isDictionary()) {
+                for (auto const& key: dict.getKeys()) {
+                    keys += dict.getKey(key).isNull() ? 0 : 1;
+                }
+            }
+        }
+    });
+    std::cout << "load " << keys << " keys: " << load << " s" << std::endl;
+
+    for (auto object_streams: {qpdf_o_preserve, qpdf_o_generate}) {
+        auto write = best_time([&]() {
+            auto pdf = open();
+            QPDFWriter w(*pdf);
+            w.setOutputMemory();
+            w.setObjectStreamMode(object_streams);
+            w.write();
+        });
+        std::cout << "open and write"
+                  << (object_streams == qpdf_o_generate ? " with object streams: " : ": ") << write
+                  << " s" << std::endl;
+    }
+}
+
+// Open filename and load all of its objects, and then destroy the QPDF, and report the best of 3
+// runs. Opening and closing are timed separately, so this doesn't use best_time.
+static void
+open_and_close(char const* filename)
+{
+    std::chrono::duration<double> best_open{1e9};
+    std::chrono::duration<double> best_close{1e9};
+    for (int i = 0; i < 3; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        auto pdf = std::make_unique<QPDF>();
+        pdf->setSuppressWarnings(true);
+        pdf->processFile(filename);
+        for (auto& obj: pdf->getAllObjects()) {
+            if (obj.isStream()) {
+                obj.getDict().getKeys();
+            }
+        }
+        auto opened = std::chrono::steady_clock::now();
+        pdf.reset();
+        auto closed = std::chrono::steady_clock::now();
+        best_open = std::min(best_open, std::chrono::duration<double>(opened - start));
+        best_close = std::min(best_close, std::chrono::duration<double>(closed - opened));
+    }
+    std::cout << "open " << best_open.count() << " s, close " << best_close.count() << " s"
+              << std::endl;
+}
+
+// Open filename and compute which objects are used by which pages, and separately open filename
+// and write it linearized, reporting each phase of writing.
+static void
+linearize(char const* filename)
+{
+    auto open = [filename]() {
+        auto pdf = std::make_unique<QPDF>();
+        pdf->setSuppressWarnings(true);
+        pdf->processFile(filename);
+        return pdf;
+    };
+
+    auto optimize = best_time([&]() {
+        auto pdf = open();
+        pdf->getAllPages();
+        pdf->optimize(std::map<int, int>());
+    });
+
+    std::vector<std::pair<std::string, double>> best_phases;
+    auto write = best_time([&]() {
+        auto pdf = open();
+        std::vector<std::pair<std::string, double>> phases;
+        QPDFWriter w(*pdf);
+        w.setOutputMemory();
+        w.setLinearization(true);
+        w.registerLinearizationTimer([&phases](std::string const& phase, double seconds) {
+            phases.emplace_back(phase, seconds);
+        });
+        w.write();
+        if (best_phases.empty()) {
+            best_phases = phases;
+        }
+        for (size_t i = 0; i < std::min(phases.size(), best_phases.size()); ++i) {
+            best_phases[i].second = std::min(best_phases[i].second, phases[i].second);
+        }
+    });
+
+    std::cout << "open and optimize " << optimize << " s, open and write linearized " << write
+              << " s" << std::endl;
+    for (auto const& [phase, seconds]: best_phases) {
+        std::cout << "  " << phase << " " << seconds << " s" << std::endl;
+    }
+}
+
+static std::string
+flate_compress(std::string const& data)
+{
+    std::string compressed;
+    Pl_String s("compressed", nullptr, compressed);
+    Pl_Flate flate("compress", &s, Pl_Flate::a_deflate);
+    flate.writeString(data);
+    flate.finish();
+    return compressed;
+}
+
+// Create a stream with the given data and filter. If decode_parms is not empty, it is parsed
+// as /DecodeParms.
+static QPDFObjectHandle
+make_stream(
+    QPDF& pdf,
+    std::string const& data,
+    std::string const& filter,
+    std::string const& decode_parms = "")
+{
+    auto stream = QPDFObjectHandle::newStream(&pdf, data);
+    stream.getDict().replaceKey("/Filter", QPDFObjectHandle::newName(filter));
+    if (!decode_parms.empty()) {
+        stream.getDict().replaceKey("/DecodeParms", QPDFObjectHandle::parse(decode_parms));
+    }
+    return stream;
+}
+
+static std::string
+decode(QPDFObjectHandle stream)
+{
+    auto b = stream.getStreamData(qpdf_dl_generalized);
+    return {reinterpret_cast<char const*>(b->getBuffer()), b->getSize()};
+}
+
+static int
+paeth(int a, int b, int c)
+{
+    int p = a + b - c;
+    int pa = std::abs(p - a);
+    int pb = std::abs(p - b);
+    int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+// Encode raw, which consists of rows of row_bytes bytes, using PNG filter types[r % types.size()]
+// for row r.
+static std::string
+png_encode(std::string const& raw, size_t row_bytes, size_t bpp, std::string const& types)
+{
+    std::string result;
+    std::string above(row_bytes, '\0');
+    for (size_t r = 0; r * row_bytes < raw.size(); ++r) {
+        auto row = raw.substr(r * row_bytes, row_bytes);
+        int type = types.at(r % types.size());
+        result += static_cast<char>(type);
+        for (size_t i = 0; i < row_bytes; ++i) {
+            int x = static_cast<unsigned char>(row[i]);
+            int a = i >= bpp ? static_cast<unsigned char>(row[i - bpp]) : 0;
+            int b = static_cast<unsigned char>(above[i]);
+            int c = i >= bpp ? static_cast<unsigned char>(above[i - bpp]) : 0;
+            int predictor = 0;
+            switch (type) {
+            case 1:
+                predictor = a;
+                break;
+            case 2:
+                predictor = b;
+                break;
+            case 3:
+                predictor = (a + b) / 2;
+                break;
+            case 4:
+                predictor = paeth(a, b, c);
+                break;
+            default:
+                break;
+            }
+            result += static_cast<char>((x - predictor) & 0xff);
+        }
+        above = row;
+    }
+    return result;
+}
+
+// Create a Flate-compressed stream of data encoded with predictor.
+static QPDFObjectHandle
+make_predictor_stream(
+    QPDF& pdf, std::string const& encoded, int predictor, int colors, int bits, int columns)
+{
+    return make_stream(
+        pdf,
+        flate_compress(encoded),
+        "/FlateDecode",
+        "<< /Predictor " + std::to_string(predictor) + " /Colors " + std::to_string(colors) +
+            " /BitsPerComponent " + std::to_string(bits) + " /Columns " +
+            std::to_string(columns) + " >>");
+}
+
+// Undo PNG predictors on image-like data compressed at level 0 so that the time is mostly spent
+// undoing the predictor.
+static void
+png_predictor(size_t megabytes)
+{
+    Pl_Flate::setCompressionLevel(0);
+    std::mt19937 rng(42);
+    QPDF pdf;
+    pdf.emptyPDF();
+    for (int colors: {1, 3, 4}) {
+        int columns = 4000;
+        size_t row_bytes = QIntC::to_size(columns * colors);
+        size_t bpp = QIntC::to_size(colors);
+        auto raw = gradient(megabytes * 1048576 / row_bytes, row_bytes, bpp, rng);
+        std::cout << "colors " << colors << ":";
+        static char const* names[] = {"none", "sub", "up", "average", "paeth"};
+        for (char type: {'\1', '\2', '\3', '\4'}) {
+            auto encoded = png_encode(raw, row_bytes, bpp, std::string(1, type));
+            auto stream = make_predictor_stream(pdf, encoded, 15, colors, 8, columns);
+            auto seconds = best_time([&]() { check(decode(stream) == raw); });
+            std::cout << " " << names[static_cast<int>(type)] << " " << seconds << " s";
+        }
+        std::cout << std::endl;
+    }
+    Pl_Flate::setCompressionLevel(-1);
+}
+
+// Encode raw, which consists of rows of row_bytes bytes of 8 or 16 bit samples, with the TIFF
+// predictor.
+static std::string
+tiff_encode(std::string const& raw, size_t row_bytes, int colors, int bits)
+{
+    size_t bytes = QIntC::to_size(bits / 8);
+    size_t stride = QIntC::to_size(colors) * bytes;
+    auto sample = [&raw, bytes](size_t i) {
+        auto p = reinterpret_cast<unsigned char const*>(raw.data() + i);
+        return bytes == 1 ? p[0] : ((static_cast<unsigned int>(p[0]) << 8) | p[1]);
+    };
+    std::string result = raw;
+    for (size_t row = 0; row < raw.size(); row += row_bytes) {
+        for (size_t i = row + stride; i < row + row_bytes; i += bytes) {
+            unsigned int difference = sample(i) - sample(i - stride);
+            if (bytes == 2) {
+                result[i] = static_cast<char>(difference >> 8);
+            }
+            result[i + bytes - 1] = static_cast<char>(difference);
+        }
+    }
+    return result;
+}
+
+// Undo the TIFF predictor on image-like data compressed at level 0.
+static void
+tiff_predictor(size_t megabytes)
+{
+    Pl_Flate::setCompressionLevel(0);
+    std::mt19937 rng(42);
+    QPDF pdf;
+    pdf.emptyPDF();
+    for (int bits: {8, 16}) {
+        for (int colors: {1, 3, 4}) {
+            int columns = 4000;
+            size_t row_bytes = QIntC::to_size(columns * colors * bits / 8);
+            auto raw =
+                gradient(megabytes * 1048576 / row_bytes, row_bytes, QIntC::to_size(colors), rng);
+            auto encoded = tiff_encode(raw, row_bytes, colors, bits);
+            auto stream = make_predictor_stream(pdf, encoded, 2, colors, bits, columns);
+            auto seconds = best_time([&]() { check(decode(stream) == raw); });
+            std::cout << "bits " << bits << ", colors " << colors << ": " << seconds << " s"
+                      << std::endl;
+        }
+    }
+    Pl_Flate::setCompressionLevel(-1);
+}
+
+// Encode data with LZW using early code change, starting over well before the table is full.
+static std::string
+lzw_encode(std::string const& data)
+{
+    std::string result;
+    unsigned long long bits = 0;
+    unsigned int bit_count = 0;
+    unsigned int code_size = 9;
+    auto write = [&](unsigned int code) {
+        bits = (bits << code_size) | code;
+        bit_count += code_size;
+        while (bit_count >= 8) {
+            bit_count -= 8;
+            result += static_cast<char>((bits >> bit_count) & 0xff);
+        }
+    };
+    std::map<std::pair<unsigned int, unsigned char>, unsigned int> table;
+    unsigned int next_code = 258;
+    write(256);
+    unsigned int current = 0;
+    for (size_t i = 0; i < data.size(); ++i) {
+        auto ch = static_cast<unsigned char>(data[i]);
+        auto iter = table.find({current, ch});
+        if (i > 0 && iter != table.end()) {
+            current = iter->second;
+            continue;
+        }
+        if (i > 0) {
+            write(current);
+            table[{current, ch}] = next_code++;
+            // The decoder adds its entry one code later, so it changes code size as it reads the
+            // code after this one.
+            if (next_code == 512 || next_code == 1024 || next_code == 2048) {
+                ++code_size;
+            } else if (next_code == 4000) {
+                write(256);
+                table.clear();
+                next_code = 258;
+                code_size = 9;
+            }
+        }
+        current = ch;
+    }
+    if (!data.empty()) {
+        write(current);
+    }
+    write(257);
+    if (bit_count) {
+        result += static_cast<char>((bits << (8 - bit_count)) & 0xff);
+    }
+    return result;
+}
+
+static void
+lzw(size_t megabytes)
+{
+    std::mt19937 rng(42);
+    QPDF pdf;
+    pdf.emptyPDF();
+    size_t size = megabytes * 1048576;
+    for (auto const& [name, data]:
+         {std::make_pair("text", text(size, rng)),
+          std::make_pair("random", random_bytes(size, rng))}) {
+        auto stream = make_stream(pdf, lzw_encode(data), "/LZWDecode");
+        auto seconds = best_time([&]() { check(decode(stream) == data); });
+        std::cout << "LZWDecode " << name << ": " << seconds << " s" << std::endl;
+    }
+}
+
+static std::string
+ascii85_encode(std::string const& data)
+{
+    std::string result;
+    for (size_t i = 0; i < data.size(); i += 4) {
+        size_t n = std::min(size_t(4), data.size() - i);
+        unsigned long long value = 0;
+        for (size_t j = 0; j < 4; ++j) {
+            value = (value << 8) | (j < n ? static_cast<unsigned char>(data[i + j]) : 0U);
+        }
+        if (n == 4 && value == 0) {
+            result += 'z';
+            continue;
+        }
+        char group[5];
+        for (size_t j = 5; j-- > 0; value /= 85) {
+            group[j] = static_cast<char>('!' + value % 85);
+        }
+        result.append(group, n + 1);
+    }
+    return result + "~>";
+}
+
+// Encode with qpdf's base64 encoder, which is used for blobs in JSON.
+static std::string
+qpdf_base64_encode(std::string const& data)
+{
+    auto blob = JSON::makeBlob([&data](Pipeline* p) { p->writeString(data); });
+    auto result = blob.unparse();
+    return result.substr(1, result.size() - 2);
+}
+
+// Decode with qpdf's base64 decoder by reading a stream whose data is given in base64 in qpdf JSON.
+static std::string
+qpdf_base64_decode(std::string const& base64)
+{
+    std::string json(
+        "{\"qpdf\": [{\"jsonversion\": 2, \"pdfversion\": \"1.3\","
+        " \"pushedinheritedpageresources\": false,"
+        " \"calledgetallpages\": false, \"maxobjectid\": 3},"
+        " {\"obj:1 0 R\": {\"value\": {\"/Type\": \"/Catalog\", \"/Pages\": \"2 0 R\"}},"
+        " \"obj:2 0 R\": {\"value\": {\"/Type\": \"/Pages\", \"/Kids\": [], \"/Count\": 0}},"
+        " \"obj:3 0 R\": {\"stream\": {\"dict\": {}, \"data\": \"" +
+        base64 +
+        "\"}},"
+        " \"trailer\": {\"value\": {\"/Root\": \"1 0 R\", \"/Size\": 4}}}]}");
+    QPDF pdf;
+    pdf.setSuppressWarnings(true);
+    pdf.createFromJSON(std::make_shared<BufferInputSource>("json", json));
+    auto b = pdf.getObject(3, 0).getRawStreamData();
+    return {reinterpret_cast<char const*>(b->getBuffer()), b->getSize()};
+}
+
+// Encode and decode random data with hexadecimal, ASCII85 and base64.
+static void
+codecs(size_t megabytes)
+{
+    std::mt19937 rng(42);
+    QPDF pdf;
+    pdf.emptyPDF();
+    auto data = random_bytes(megabytes * 1048576, rng);
+    auto hex = QUtil::hex_encode(data);
+    auto hex_stream = make_stream(pdf, hex + ">", "/ASCIIHexDecode");
+    auto ascii85_stream = make_stream(pdf, ascii85_encode(data), "/ASCII85Decode");
+    auto base64 = qpdf_base64_encode(data);
+    auto report = [](char const* what, std::function<void()> fn) {
+        std::cout << what << ": " << best_time(fn) << " s" << std::endl;
+    };
+    report("hex_encode", [&]() { check(QUtil::hex_encode(data) == hex); });
+    report("hex_decode", [&]() { check(QUtil::hex_decode(hex) == data); });
+    report("ASCIIHexDecode", [&]() { check(decode(hex_stream) == data); });
+    report("ASCII85Decode", [&]() { check(decode(ascii85_stream) == data); });
+    report("base64 encode", [&]() { check(qpdf_base64_encode(data) == base64); });
+    report("base64 decode", [&]() { check(qpdf_base64_decode(base64) == data); });
+}
+
+// Compress and uncompress text-like data split into streams of several sizes, writing each stream
+// in 64 KB pieces, as when stream data is read from a file, and all at once with
+// Pl_Flate::writeAll.
+static void
+flate(size_t megabytes)
+{
+    std::mt19937 rng(42);
+    auto data = text(megabytes * 1048576, rng);
+    for (size_t stream_size: {size_t(16384), size_t(262144), size_t(4194304)}) {
+        std::vector<std::string> streams;
+        std::vector<std::string> compressed;
+        for (size_t i = 0; i < data.size(); i += stream_size) {
+            streams.push_back(data.substr(i, stream_size));
+            compressed.push_back(flate_compress(streams.back()));
+        }
+        for (auto action: {Pl_Flate::a_deflate, Pl_Flate::a_inflate}) {
+            auto const& inputs = action == Pl_Flate::a_deflate ? streams : compressed;
+            auto const& outputs = action == Pl_Flate::a_deflate ? compressed : streams;
+            for (size_t chunk: {size_t(65536), size_t(0)}) {
+                auto seconds = best_time([&]() {
+                    for (size_t n = 0; n < inputs.size(); ++n) {
+                        auto const& input = inputs.at(n);
+                        std::string out;
+                        Pl_String s("output", nullptr, out);
+                        Pl_Flate fl("flate", &s, action);
+                        auto p = reinterpret_cast<unsigned char const*>(input.data());
+                        if (chunk == 0) {
+                            fl.writeAll(p, input.size());
+                        } else {
+                            for (size_t i = 0; i < input.size(); i += chunk) {
+                                fl.write(p + i, std::min(chunk, input.size() - i));
+                            }
+                            fl.finish();
+                        }
+                        check(out == outputs.at(n));
+                    }
+                });
+                std::cout << (action == Pl_Flate::a_deflate ? "deflate" : "inflate") << " "
+                          << stream_size / 1024 << " KB streams "
+                          << (chunk ? "in pieces: " : "all at once: ") << seconds << " s"
+                          << std::endl;
+            }
+        }
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    whoami = QUtil::getWhoami(argv[0]);
+    if (argc < 2) {
+        usage();
+    }
+    std::string mode = argv[1];
+    bool has_file =
+        (mode == "find" || mode == "rewrite" || mode == "open" || mode == "linearize");
+    char const* filename = nullptr;
+    int arg = 2;
+    if (has_file) {
+        if (argc < 3) {
+            usage();
+        }
+        filename = argv[arg++];
+    }
+    if (argc > arg + 1 || (has_file && mode != "find" && argc > arg)) {
+        usage();
+    }
+    size_t megabytes = argc > arg ? QUtil::string_to_uint(argv[arg]) : 16;
+
+    try {
+        if (mode == "find") {
+            find(filename, megabytes);
+        } else if (mode == "tokenizer") {
+            tokenizer(megabytes);
+        } else if (mode == "rewrite") {
+            rewrite(filename);
+        } else if (mode == "open") {
+            open_and_close(filename);
+        } else if (mode == "linearize") {
+            linearize(filename);
+        } else if (mode == "png-predictor") {
+            png_predictor(megabytes);
+        } else if (mode == "tiff-predictor") {
+            tiff_predictor(megabytes);
+        } else if (mode == "lzw") {
+            lzw(megabytes);
+        } else if (mode == "codecs") {
+            codecs(megabytes);
+        } else if (mode == "flate") {
+            flate(megabytes);
+        } else {
+            usage();
+        }
+    } catch (std::exception& e) {
+        std::cerr << whoami << ": " << e.what() << std::endl;
+        exit(2);
+    }
+    return 0;
+}
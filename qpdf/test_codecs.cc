@@ -0,0 +1,287 @@
+#include "test_helpers.hh"
+
+#include <qpdf/Pl_ASCII85Decoder.hh>
+#include <qpdf/Pl_ASCIIHexDecoder.hh>
+#include <qpdf/Pl_Base64.hh>
+#include <qpdf/Pl_String.hh>
+#include <qpdf/QUtil.hh>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// Compare QUtil::hex_encode and QUtil::hex_decode, Pl_ASCIIHexDecoder, Pl_ASCII85Decoder and
+// Pl_Base64 with simple implementations for random data with and without white space. Data is
+// written to the pipelines in pieces of several sizes, including one byte at a time, so that
+// groups are split at different places, and Pl_Base64 encodes data and decodes it again in the same
+// chain. Then decode some invalid data and print how much data was decoded and the errors.
+
+using namespace test_helpers;
+
+static std::string
+hex_encode(std::string const& data, bool upper)
+{
+    auto digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::string result;
+    for (auto ch: data) {
+        result += digits[static_cast<unsigned char>(ch) >> 4];
+        result += digits[ch & 0xf];
+    }
+    return result;
+}
+
+static int
+hex_value(char ch)
+{
+    auto p = strchr("0123456789abcdef", tolower(static_cast<unsigned char>(ch)));
+    return (ch && p) ? static_cast<int>(p - "0123456789abcdef") : -1;
+}
+
+static std::string
+hex_decode(std::string const& data)
+{
+    std::string result;
+    int high = -1;
+    for (auto ch: data) {
+        int v = hex_value(ch);
+        if (v < 0) {
+            continue;
+        } else if (high < 0) {
+            high = v;
+        } else {
+            result += static_cast<char>((high << 4) | v);
+            high = -1;
+        }
+    }
+    if (high >= 0) {
+        result += static_cast<char>(high << 4);
+    }
+    return result;
+}
+
+static std::string
+ascii85_encode(std::string const& data)
+{
+    std::string result;
+    for (size_t i = 0; i < data.size(); i += 4) {
+        size_t n = std::min(size_t(4), data.size() - i);
+        unsigned long long value = 0;
+        for (size_t j = 0; j < 4; ++j) {
+            value = (value << 8) | (j < n ? static_cast<unsigned char>(data[i + j]) : 0U);
+        }
+        if (n == 4 && value == 0) {
+            result += 'z';
+            continue;
+        }
+        char group[5];
+        for (size_t j = 5; j-- > 0; value /= 85) {
+            group[j] = static_cast<char>('!' + value % 85);
+        }
+        result.append(group, n + 1);
+    }
+    return result + "~>";
+}
+
+static std::string
+base64_encode(std::string const& data)
+{
+    static char const* digits = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string result;
+    for (size_t i = 0; i < data.size(); i += 3) {
+        size_t n = std::min(size_t(3), data.size() - i);
+        unsigned int value = 0;
+        for (size_t j = 0; j < 3; ++j) {
+            value = (value << 8) | (j < n ? static_cast<unsigned char>(data[i + j]) : 0U);
+        }
+        for (size_t j = 0; j < 4; ++j) {
+            result += j <= n ? digits[(value >> (18 - 6 * j)) & 0x3f] : '=';
+        }
+    }
+    return result;
+}
+
+// Insert a space or a newline before about one in every `every` characters.
+static std::string
+add_space(std::string const& data, unsigned int every, std::mt19937& rng)
+{
+    std::string result;
+    for (auto ch: data) {
+        if (rng() % every == 0) {
+            result += (rng() & 1) ? '\n' : ' ';
+        }
+        result += ch;
+    }
+    return result;
+}
+
+// Write data to p in pieces of chunk bytes and finish it.
+static void
+write_in_pieces(Pipeline& p, std::string const& data, size_t chunk)
+{
+    auto buf = reinterpret_cast<unsigned char const*>(data.data());
+    for (size_t i = 0; i < data.size(); i += chunk) {
+        p.write(buf + i, std::min(chunk, data.size() - i));
+    }
+    p.finish();
+}
+
+// Create the decoder named at the start of description, writing to next.
+static std::unique_ptr<Pipeline>
+make_decoder(std::string const& description, Pipeline* next)
+{
+    if (description.substr(0, 3) == "hex") {
+        return std::make_unique<Pl_ASCIIHexDecoder>("hex", next);
+    } else if (description.substr(0, 7) == "ascii85") {
+        return std::make_unique<Pl_ASCII85Decoder>("ascii85", next);
+    }
+    return std::make_unique<Pl_Base64>("base64", next, Pl_Base64::a_decode);
+}
+
+// Decode data in pieces of chunk bytes with the decoder named at the start of description. Return
+// the error, if any, and set decoded to the data decoded before it.
+static std::string
+try_decode(
+    std::string const& description, std::string const& data, size_t chunk, std::string& decoded)
+{
+    Pl_String s("decoded", nullptr, decoded);
+    auto decoder = make_decoder(description, &s);
+    try {
+        write_in_pieces(*decoder, data, chunk);
+    } catch (std::exception& e) {
+        return e.what();
+    }
+    return "";
+}
+
+// Decode data, which must succeed, in pieces of each size and compare it with expected.
+static void
+check_decode(
+    std::string const& description,
+    std::string const& data,
+    std::string const& expected,
+    size_t size)
+{
+    for (size_t chunk: {size_t(1), size_t(2), size_t(3), size_t(7), size_t(1021), data.size()}) {
+        std::string decoded;
+        auto error = try_decode(description, data, std::max(chunk, size_t(1)), decoded);
+        if (!error.empty() || decoded != expected) {
+            std::cout << description << " failed for " << size << " bytes, pieces of " << chunk
+                      << std::endl;
+            exit(2);
+        }
+    }
+}
+
+static void
+fail(std::string const& what, size_t size)
+{
+    std::cout << what << " failed for " << size << " bytes" << std::endl;
+    exit(2);
+}
+
+// Print how much data was decoded and the error, if any, after checking that writing the data one
+// byte at a time gives the same result.
+static void
+check_invalid(std::string const& description, std::string const& data)
+{
+    std::string decoded;
+    auto error = try_decode(description, data, data.size(), decoded);
+    std::string decoded1;
+    if (try_decode(description, data, 1, decoded1) != error || decoded1 != decoded) {
+        std::cout << description << ": result differs when written one byte at a time"
+                  << std::endl;
+        exit(2);
+    }
+    std::cout << description << ": " << decoded.size() << " bytes"
+              << (error.empty() ? "" : ", exception: " + error) << std::endl;
+}
+
+int
+main()
+{
+    std::mt19937 rng(42);
+    for (size_t size:
+         {0U, 1U, 2U, 3U, 4U, 5U, 15U, 16U, 17U, 31U, 32U, 33U, 100U, 1000U, 100000U}) {
+        auto data = random_bytes(size, rng);
+        if (size >= 8) {
+            // Exercise z in ASCII85.
+            std::fill(data.begin() + 4, data.begin() + 8, '\0');
+        }
+        if (QUtil::hex_encode(data) != hex_encode(data, false)) {
+            fail("hex_encode", size);
+        }
+        for (auto upper: {false, true}) {
+            for (unsigned int every: {1000000U, 100U, 3U}) {
+                auto hex = add_space(hex_encode(data, upper), every, rng);
+                if (QUtil::hex_decode(hex) != data) {
+                    fail("hex_decode", size);
+                }
+                check_decode("hex", hex + ">", data, size);
+            }
+        }
+        // hex_decode ignores anything other than hex digits.
+        auto noisy = add_space(hex_encode(data, false), 10, rng);
+        for (auto& ch: noisy) {
+            if (ch == ' ' || ch == '\n') {
+                ch = static_cast<char>(rng() & 0xff);
+            }
+        }
+        if (QUtil::hex_decode(noisy) != hex_decode(noisy)) {
+            fail("hex_decode with other characters", size);
+        }
+        if (QUtil::hex_decode(noisy + "a") != hex_decode(noisy + "a")) {
+            fail("hex_decode with odd digits", size);
+        }
+        for (unsigned int every: {1000000U, 100U, 3U}) {
+            check_decode("ascii85", add_space(ascii85_encode(data), every, rng), data, size);
+        }
+        auto base64 = base64_encode(data);
+        for (size_t chunk: {size_t(1), size_t(2), size_t(5), size_t(7), size_t(1021), size}) {
+            std::string round_trip;
+            Pl_String s_round_trip("round trip", nullptr, round_trip);
+            Pl_Base64 decode("decode", &s_round_trip, Pl_Base64::a_decode);
+            std::string encoded;
+            Pl_String s_encoded("encoded", &decode, encoded);
+            Pl_Base64 encode("encode", &s_encoded, Pl_Base64::a_encode);
+            write_in_pieces(encode, data, std::max(chunk, size_t(1)));
+            if (encoded != base64) {
+                fail("base64 encode in pieces of " + std::to_string(chunk), size);
+            }
+            if (round_trip != data) {
+                fail("base64 round trip in pieces of " + std::to_string(chunk), size);
+            }
+        }
+        for (unsigned int every: {1000000U, 100U, 3U}) {
+            check_decode("base64", add_space(base64, every, rng), data, size);
+        }
+        std::replace(base64.begin(), base64.end(), '+', '-');
+        std::replace(base64.begin(), base64.end(), '/', '_');
+        check_decode("URL-safe base64", base64, data, size);
+    }
+
+    // Put invalid characters far enough into the data to follow complete blocks.
+    std::string long_hex(100, 'a');
+    check_invalid("hex invalid", long_hex + "ag>");
+    check_invalid("hex invalid after space", long_hex + "a x>");
+    check_invalid("hex odd digits", long_hex + "a>");
+    check_invalid("hex data after end", long_hex + ">ab");
+    check_invalid("hex no end", long_hex + "a");
+    std::string long_ascii85(100, 'u');
+    check_invalid("ascii85 invalid", long_ascii85 + "!!v!!~>");
+    check_invalid("ascii85 z in group", long_ascii85 + "!!z~>");
+    check_invalid("ascii85 partial group", long_ascii85 + "!!!~>");
+    check_invalid("ascii85 broken end", long_ascii85 + "~x");
+    check_invalid("ascii85 data after end", long_ascii85 + "~>!!!!!");
+    check_invalid("ascii85 no end", long_ascii85 + "!!");
+    std::string long_base64(100, 'A');
+    check_invalid("base64 invalid", long_base64 + "AA.A");
+    check_invalid("base64 data after pad", long_base64 + "AA==AAAA");
+    check_invalid("base64 pad in group", long_base64 + "A=AA");
+    check_invalid("base64 partial group", long_base64 + "AA");
+    return 0;
+}
@@ -3453,6 +3453,160 @@ test_98(QPDF& pdf, char const* arg2)
         "}");
 }
 
+static void
+test_99(QPDF& pdf, char const* arg2)
+{
+    // Test that an object used to replace an indirect object keeps its value when the indirect
+    // object is replaced again or its QPDF is destroyed. This test is built for minimal.pdf.
+
+    auto og = pdf.getObject(5, 0).getObjGen();
+    auto h1 = "[1 2]"_qpdf;
+    pdf.replaceObject(og, h1);
+    assert(pdf.getObject(og).unparseResolved() == "[ 1 2 ]");
+    h1.appendItem("3"_qpdf);
+    assert(pdf.getObject(og).unparseResolved() == "[ 1 2 3 ]");
+    pdf.getObject(og).appendItem("4"_qpdf);
+    assert(h1.unparseResolved() == "[ 1 2 3 4 ]");
+
+    auto h2 = "<< /A 1 >>"_qpdf;
+    pdf.replaceObject(og, h2);
+    assert(pdf.getObject(og).unparseResolved() == "<< /A 1 >>");
+    assert(!h1.isIndirect() && h1.unparse() == "[ 1 2 3 4 ]");
+    pdf.swapObjects(og, pdf.getObject(6, 0).getObjGen());
+    assert(pdf.getObject(6, 0).unparseResolved() == "<< /A 1 >>");
+    assert(h2.getObjGen() == QPDFObjGen(6, 0));
+
+    QPDFObjectHandle h3;
+    {
+        auto other = QPDF::create();
+        other->emptyPDF();
+        auto other_og = other->makeIndirectObject("(potato)"_qpdf).getObjGen();
+        h3 = "[/A << /B 1 >>]"_qpdf;
+        other->replaceObject(other_og, h3);
+        assert(other->getObject(other_og).getArrayItem(0).unparseResolved() == "/A");
+    }
+    assert(!h3.isIndirect() && h3.unparse() == "[ /A << /B 1 >> ]");
+    assert(!h3.getOwningQPDF());
+}
+
+static void
+test_100(QPDF& pdf, char const* arg2)
+{
+    // Test that arrays and dictionaries whose parsing was deferred can't be used once their QPDF
+    // has been destroyed unless they were parsed before. arg2 is many-nulls.pdf, whose /Nulls is
+    // an array of large direct arrays.
+
+    QPDFObjectHandle read;
+    QPDFObjectHandle unread;
+    std::string expected;
+    {
+        QPDF lazy;
+        lazy.setLazyParsing(true);
+        lazy.processFile(arg2);
+        auto nulls = lazy.getTrailer().getKey("/Nulls");
+        read = nulls.getArrayItem(0);
+        unread = nulls.getArrayItem(1);
+        assert(read.isArray() && unread.isArray());
+        expected = read.unparse();
+        assert(read.getArrayNItems() > 10000);
+    }
+    assert(read.isArray() && read.unparse() == expected);
+    assert(unread.isDestroyed() && !unread.isArray());
+    try {
+        unread.unparse();
+        assert(false);
+    } catch (std::logic_error&) {
+    }
+}
+
+static void
+test_101(QPDF& pdf, char const* arg2)
+{
+    // Test that QPDF::forEachXRefEntry visits the same entries in the same order as
+    // QPDF::getXRefTable.
+
+    auto table = pdf.getXRefTable();
+    auto iter = table.begin();
+    pdf.forEachXRefEntry([&](QPDFObjGen og, QPDFXRefEntry const& entry) {
+        assert(iter != table.end());
+        assert(og == iter->first);
+        assert(entry.getType() == iter->second.getType());
+        if (entry.getType() == 1) {
+            assert(entry.getOffset() == iter->second.getOffset());
+        } else if (entry.getType() == 2) {
+            assert(entry.getObjStreamNumber() == iter->second.getObjStreamNumber());
+            assert(entry.getObjStreamIndex() == iter->second.getObjStreamIndex());
+        }
+        ++iter;
+    });
+    assert(iter == table.end());
+}
+
+static void
+test_102(QPDF& pdf, char const* arg2)
+{
+    // Test dictionaries with more keys than are kept in a sorted vector. Keys are added out of
+    // order, and some are replaced and removed after the dictionary has switched to a map.
+
+    auto key = [](int i) {
+        auto digits = std::to_string(i);
+        return "/K" + std::string(3 - digits.size(), '0') + digits;
+    };
+    std::map<std::string, std::string> expected;
+    std::string text = "<<";
+    for (int i = 0; i < 300; ++i) {
+        // 7 and 300 are coprime, so this visits every key once.
+        int k = (i * 7) % 300;
+        text += " " + key(k) + " " + std::to_string(k);
+        expected[key(k)] = std::to_string(k);
+    }
+    text += " >>";
+
+    auto unparse = [](std::map<std::string, std::string> const& items) {
+        std::string result = "<< ";
+        for (auto const& [k, v]: items) {
+            result += k + " " + v + " ";
+        }
+        return result + ">>";
+    };
+
+    auto dict = QPDFObjectHandle::parse(text);
+    assert(dict.unparse() == unparse(expected));
+    assert(dict.getKeys().size() == 300);
+
+    dict.replaceKey("/K150", QPDFObjectHandle::newString("replaced"));
+    expected["/K150"] = "(replaced)";
+    dict.replaceKey("/A", QPDFObjectHandle::newBool(true));
+    expected["/A"] = "true";
+    for (int k: {0, 10, 299}) {
+        dict.removeKey(key(k));
+        expected.erase(key(k));
+    }
+    dict.removeKey("/missing");
+    assert(!dict.hasKey("/K010") && dict.hasKey("/K011"));
+    assert(dict.getKey("/K150").getUTF8Value() == "replaced");
+    assert(dict.unparse() == unparse(expected));
+
+    // A copy is independent of the original.
+    auto copy = dict.shallowCopy();
+    copy.removeKey("/K001");
+    copy.replaceKey("/K002", QPDFObjectHandle::newNull());
+    assert(dict.unparse() == unparse(expected));
+    assert(!copy.hasKey("/K001") && copy.getKey("/K002").isNull());
+
+    // Write the dictionary and read it back.
+    pdf.emptyPDF();
+    pdf.getTrailer().replaceKey("/Large", pdf.makeIndirectObject(dict));
+    QPDFWriter w(pdf);
+    w.setOutputMemory();
+    w.write();
+    auto b = w.getBufferSharedPointer();
+    QPDF in;
+    in.processMemoryFile(
+        "large dictionary", reinterpret_cast<char const*>(b->getBuffer()), b->getSize());
+    assert(in.getTrailer().getKey("/Large").unparseResolved() == unparse(expected));
+}
+
 void
 runtest(int n, char const* filename1, char const* arg2)
 {
@@ -3460,7 +3614,7 @@ runtest(int n, char const* filename1, char const* arg2)
     // the test suite to see how the test is invoked to find the file
     // that the test is supposed to operate on.
 
-    std::set<int> ignore_filename = {61, 81, 83, 84, 85, 86, 87, 92, 95, 96};
+    std::set<int> ignore_filename = {61, 81, 83, 84, 85, 86, 87, 92, 95, 96, 100, 102};
 
     if (n == 0) {
         // Throw in some random test cases that don't fit anywhere
@@ -3554,7 +3708,8 @@ runtest(int n, char const* filename1, char const* arg2)
         {78, test_78}, {79, test_79}, {80, test_80}, {81, test_81}, {82, test_82}, {83, test_83},
         {84, test_84}, {85, test_85}, {86, test_86}, {87, test_87}, {88, test_88}, {89, test_89},
         {90, test_90}, {91, test_91}, {92, test_92}, {93, test_93}, {94, test_94}, {95, test_95},
-        {96, test_96}, {97, test_97}, {98, test_98}};
+        {96, test_96}, {97, test_97}, {98, test_98}, {99, test_99}, {100, test_100},
+        {101, test_101}, {102, test_102}};
 
     auto fn = test_functions.find(n);
     if (fn == test_functions.end()) {
@@ -0,0 +1,163 @@
+#include <qpdf/BufferInputSource.hh>
+#include <qpdf/FileInputSource.hh>
+#include <qpdf/MmapInputSource.hh>
+#include <qpdf/QIntC.hh>
+#include <qpdf/QUtil.hh>
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Write test data to the file given on the command line and compare the results of many searches
+// with InputSource::findFirst and findLast using each kind of input source with the results of a
+// simple search of the same data.
+
+namespace
+{
+    // Accept a match if accept returns true for its offset. Like the finders used by the library,
+    // read from the input source while checking.
+    class Finder: public InputSource::Finder
+    {
+      public:
+        Finder(InputSource& is, std::function<bool(qpdf_offset_t)> accept) :
+            is(is),
+            accept(accept)
+        {
+        }
+        ~Finder() override = default;
+
+        bool
+        check() override
+        {
+            auto offset = is.tell();
+            char ch;
+            is.read(&ch, 1);
+            return accept(offset);
+        }
+
+      private:
+        InputSource& is;
+        std::function<bool(qpdf_offset_t)> accept;
+    };
+} // namespace
+
+static std::string
+make_check_data()
+{
+    // Use a small alphabet so there are many full and partial matches for the search strings, and
+    // place matches on either side of the block boundaries used by the buffered search.
+    std::string data;
+    unsigned int seed = 17;
+    static char const alphabet[] = "endstream obj\nEI startxref\r\0\xff";
+    for (size_t i = 0; i < 300000; ++i) {
+        seed = seed * 1103515245U + 12345U;
+        data += alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+    }
+    for (size_t boundary:
+         {1024U, 1024U + 4096U, 1024U + 4096U + 16384U, 1024U + 4096U + 16384U + 65536U}) {
+        for (size_t i = boundary - 12; i < boundary + 12; i += 11) {
+            data.replace(i, 9, "endstream");
+        }
+    }
+    data.replace(data.size() - 1500, 9, "startxref");
+    data.replace(data.size() - 500, 9, "startxref");
+    return data;
+}
+
+static void
+check_source(InputSource& is, std::string const& data, std::string const& name, int& errors)
+{
+    size_t const size = data.size();
+    std::function<bool(qpdf_offset_t)> const accepts[] = {
+        [](qpdf_offset_t) { return true; },
+        [](qpdf_offset_t o) { return o % 3 == 0; },
+        [](qpdf_offset_t) { return false; }};
+    for (std::string needle: {"e", "end", "endstream", "EI", "startxref"}) {
+        for (size_t offset: {size_t(0), size_t(1), size_t(1000), size_t(1019), size_t(5000),
+                             size_t(70000), size - 10, size - 1, size}) {
+            for (size_t len: {size_t(0), size_t(1), size_t(3), size_t(1024), size_t(70000)}) {
+                for (size_t a = 0; a < 3; ++a) {
+                    // Find the expected result with a simple search.
+                    qpdf_offset_t expected = -1;
+                    for (size_t i = offset; i + needle.size() <= size; ++i) {
+                        if ((len != 0) && (i - offset >= len)) {
+                            break;
+                        }
+                        if ((data.compare(i, needle.size(), needle) == 0) &&
+                            accepts[a](QIntC::to_offset(i))) {
+                            expected = QIntC::to_offset(i);
+                            break;
+                        }
+                    }
+                    Finder f(is, accepts[a]);
+                    qpdf_offset_t result =
+                        is.findFirst(needle.c_str(), QIntC::to_offset(offset), len, f)
+                        ? is.tell() - 1
+                        : -1;
+                    if (result != expected) {
+                        ++errors;
+                        std::cout << name << ": findFirst " << needle.size() << " chars at "
+                                  << offset << " len " << len << " check " << a << ": expected "
+                                  << expected << ", got " << result << std::endl;
+                    }
+                }
+            }
+        }
+    }
+
+    // findLast finds the last match, so search backwards for the expected result.
+    qpdf_offset_t start = QIntC::to_offset(size - 1054);
+    auto expected = QIntC::to_offset(data.rfind("startxref"));
+    Finder f(is, [](qpdf_offset_t) { return true; });
+    qpdf_offset_t result = -1;
+    if (is.findLast("startxref", start, 0, f)) {
+        result = is.tell() - 1;
+    }
+    if (expected < start) {
+        expected = -1;
+    }
+    if (result != expected) {
+        ++errors;
+        std::cout << name << ": findLast: expected " << expected << ", got " << result
+                  << std::endl;
+    }
+}
+
+static void
+check(char const* filename)
+{
+    std::string data = make_check_data();
+    {
+        QUtil::FileCloser fc(QUtil::safe_fopen(filename, "wb"));
+        fwrite(data.data(), 1, data.size(), fc.f);
+    }
+
+    int errors = 0;
+    BufferInputSource bis("buffer", data);
+    check_source(bis, data, "buffer", errors);
+    FileInputSource fis(filename);
+    check_source(fis, data, "file", errors);
+    MmapInputSource mis(filename);
+    check_source(mis, data, "mmap", errors);
+    if (errors != 0) {
+        exit(2);
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    if (argc != 2) {
+        std::cerr << "Usage: test_find file" << std::endl;
+        exit(2);
+    }
+    try {
+        check(argv[1]);
+    } catch (std::exception& e) {
+        std::cerr << "test_find: " << e.what() << std::endl;
+        exit(2);
+    }
+    return 0;
+}
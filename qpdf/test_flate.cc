@@ -0,0 +1,215 @@
+#include "test_helpers.hh"
+
+#include <qpdf/Pl_Flate.hh>
+#include <qpdf/QIntC.hh>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Compress a variety of data at several compression levels both by writing it in pieces of several
+// sizes, including one byte at a time for smaller data, and all at once with Pl_Flate::writeAll and
+// check that the results are identical. Uncompress it in pieces of the same sizes and with writeAll
+// and a range of output size hints, including ones that are far too small or large, and check that
+// the original data comes back, in a single write for writeAll. Also compress and uncompress in
+// the same chain. Then uncompress some invalid data in several ways and print what happened, which
+// must be the same every way.
+
+using namespace test_helpers;
+
+// Collect output and count the calls to write().
+class Collector: public Pipeline
+{
+  public:
+    Collector() :
+        Pipeline("collector", nullptr)
+    {
+    }
+
+    void
+    write(unsigned char const* buf, size_t len) override
+    {
+        data.append(reinterpret_cast<char const*>(buf), len);
+        ++writes;
+    }
+
+    void
+    finish() override
+    {
+    }
+
+    std::string data;
+    int writes{0};
+};
+
+struct Result
+{
+    std::string data;
+    int writes{0};
+    std::string error;
+    std::vector<std::string> warnings;
+
+    bool
+    operator==(Result const& other) const
+    {
+        return data == other.data && error == other.error && warnings == other.warnings;
+    }
+};
+
+// Run data through a Pl_Flate by calling write() with pieces of chunk bytes followed by finish(),
+// or with writeAll() if chunk is 0.
+static Result
+run(Pl_Flate::action_e action, std::string const& data, size_t chunk, size_t hint = 0)
+{
+    Result result;
+    Collector c;
+    Pl_Flate flate("flate", &c, action);
+    flate.setWarnCallback([&result](char const* msg, int) { result.warnings.emplace_back(msg); });
+    auto p = reinterpret_cast<unsigned char const*>(data.data());
+    try {
+        if (chunk == 0) {
+            flate.writeAll(p, data.size(), hint);
+        } else {
+            for (size_t i = 0; i < data.size(); i += chunk) {
+                flate.write(p + i, std::min(chunk, data.size() - i));
+            }
+            flate.finish();
+        }
+    } catch (std::exception& e) {
+        result.error = e.what();
+    }
+    result.data = c.data;
+    result.writes = c.writes;
+    return result;
+}
+
+static void
+fail(std::string const& what)
+{
+    std::cout << what << std::endl;
+    exit(2);
+}
+
+// Write sizes to compare with writeAll, leaving out one byte at a time for larger data to keep the
+// run time reasonable.
+static std::vector<size_t>
+chunks(size_t size)
+{
+    if (size > 100000) {
+        return {7, 1000, 65537};
+    }
+    return {1, 7, 1000, 65537};
+}
+
+// If memory_limit is set, output is passed on in smaller pieces when input is written in smaller
+// pieces, so more of it may be passed on before the limit is exceeded, but never more than the
+// limit.
+static void
+check_invalid(
+    std::string const& description, std::string const& compressed, size_t memory_limit = 0)
+{
+    auto result = run(Pl_Flate::a_inflate, compressed, 0);
+    for (auto chunk: chunks(compressed.size())) {
+        auto pieces = run(Pl_Flate::a_inflate, compressed, chunk);
+        bool same_data =
+            memory_limit ? pieces.data.size() <= memory_limit : pieces.data == result.data;
+        if (!same_data || pieces.error != result.error || pieces.warnings != result.warnings) {
+            fail(description + ": writeAll differs from write in pieces of " +
+                 std::to_string(chunk));
+        }
+    }
+    std::cout << description << ": " << result.data.size() << " bytes" << std::endl;
+    if (!result.error.empty()) {
+        std::cout << "  error: " << result.error << std::endl;
+    }
+    for (auto const& warning: result.warnings) {
+        std::cout << "  warning: " << warning << std::endl;
+    }
+}
+
+int
+main()
+{
+    std::mt19937 rng(42);
+    std::vector<std::string> inputs;
+    for (int size: {1, 10, 1000, 65536, 100000, 1000000}) {
+        inputs.push_back(text(QIntC::to_size(size), rng));
+        inputs.push_back(random_bytes(QIntC::to_size(size), rng));
+    }
+    inputs.emplace_back(5000000, '\0');
+
+    for (int level: {-1, 1, 9}) {
+        Pl_Flate::setCompressionLevel(level);
+        for (auto const& data: inputs) {
+            auto description = std::to_string(data.size()) + " bytes at level " +
+                std::to_string(level);
+            auto all = run(Pl_Flate::a_deflate, data, 0);
+            if (all.writes != 1) {
+                fail("compressing " + description + " with writeAll used several writes");
+            }
+            for (auto chunk: chunks(data.size())) {
+                auto pieces = " in pieces of " + std::to_string(chunk);
+                if (!(run(Pl_Flate::a_deflate, data, chunk) == all)) {
+                    fail("compressing " + description + pieces + " differs");
+                }
+                auto inflated = run(Pl_Flate::a_inflate, all.data, chunk);
+                if (inflated.data != data || !inflated.error.empty() ||
+                    !inflated.warnings.empty()) {
+                    fail("uncompressing " + description + pieces + " failed");
+                }
+            }
+
+            Collector c;
+            Pl_Flate inflate("inflate", &c, Pl_Flate::a_inflate);
+            Pl_Flate deflate("deflate", &inflate, Pl_Flate::a_deflate);
+            auto p = reinterpret_cast<unsigned char const*>(data.data());
+            for (size_t i = 0; i < data.size(); i += 7) {
+                deflate.write(p + i, std::min(size_t(7), data.size() - i));
+            }
+            deflate.finish();
+            if (c.data != data) {
+                fail("round trip of " + description + " failed");
+            }
+            for (size_t hint: {size_t(0), size_t(1), data.size(), size_t(1) << 40}) {
+                auto inflated = run(Pl_Flate::a_inflate, all.data, 0, hint);
+                if (inflated.data != data || !inflated.error.empty() ||
+                    !inflated.warnings.empty() || inflated.writes != 1) {
+                    fail("uncompressing " + std::to_string(data.size()) +
+                         " bytes with hint " + std::to_string(hint) + " failed");
+                }
+            }
+        }
+    }
+    Pl_Flate::setCompressionLevel(-1);
+
+    auto compressed = run(Pl_Flate::a_deflate, inputs.at(8), 0).data;
+    check_invalid("complete", compressed);
+    check_invalid("truncated", compressed.substr(0, compressed.size() / 2));
+    check_invalid("missing checksum", compressed.substr(0, compressed.size() - 4));
+    auto bad_checksum = compressed;
+    bad_checksum.back() = static_cast<char>(bad_checksum.back() ^ 1);
+    check_invalid("bad checksum", bad_checksum);
+    auto bad_data = compressed;
+    bad_data.at(bad_data.size() / 2) = static_cast<char>(bad_data.at(bad_data.size() / 2) ^ 0x55);
+    check_invalid("bad data", bad_data);
+    check_invalid("not compressed", "not compressed data");
+
+    Pl_Flate::setMemoryLimit(100000);
+    check_invalid("memory limit", run(Pl_Flate::a_deflate, inputs.back(), 0).data, 100000);
+    Pl_Flate::setMemoryLimit(0);
+
+    Collector c;
+    Pl_Flate flate("flate", &c, Pl_Flate::a_deflate);
+    flate.finish();
+    try {
+        flate.writeAll(reinterpret_cast<unsigned char const*>("data"), 4);
+        fail("writeAll after finish didn't throw");
+    } catch (std::logic_error& e) {
+        std::cout << "after finish: " << e.what() << std::endl;
+    }
+    return 0;
+}
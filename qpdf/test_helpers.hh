@@ -0,0 +1,65 @@
+#ifndef TEST_HELPERS_HH
+#define TEST_HELPERS_HH
+
+// Helpers that create test data, shared by test programs and by the benchmark program.
+
+#include <random>
+#include <string>
+
+namespace test_helpers
+{
+    // Content-stream-like text made of whole lines, at least size bytes long
+    inline std::string
+    content_stream(size_t size)
+    {
+        static char const* line = "BT /F1 12 Tf 72 712.5 Td (The quick brown fox jumped) Tj ET q "
+                                  "1 0 0 1 0 0 cm [1 2 3] 0 d /OC << /Type /OCMD /OCGs [5 0 R] >> "
+                                  "BDC EMC Q\n";
+        std::string result;
+        while (result.size() < size) {
+            result += line;
+        }
+        return result;
+    }
+
+    inline std::string
+    random_bytes(size_t size, std::mt19937& rng)
+    {
+        std::string result;
+        for (size_t i = 0; i < size; ++i) {
+            result += static_cast<char>(rng() & 0xff);
+        }
+        return result;
+    }
+
+    // Pseudo-text made of words from a small vocabulary
+    inline std::string
+    text(size_t size, std::mt19937& rng)
+    {
+        static char const* words[] = {
+            "the ", "quick ", "brown ", "fox ", "jumps ", "over ", "lazy ", "dog ", "stream ",
+            "object ", "page ", "font ", "resources ", "/Type ", "0 0 612 792 ", "Tj\n", "BT ",
+            "ET\n"};
+        std::string result;
+        while (result.size() < size) {
+            result += words[rng() % (sizeof(words) / sizeof(words[0]))];
+        }
+        result.resize(size);
+        return result;
+    }
+
+    // Image-like data: rows of row_bytes bytes of a smooth gradient with some noise.
+    inline std::string
+    gradient(size_t rows, size_t row_bytes, size_t bytes_per_pixel, std::mt19937& rng)
+    {
+        std::string result;
+        for (size_t r = 0; r < rows; ++r) {
+            for (size_t i = 0; i < row_bytes; ++i) {
+                result += static_cast<char>((r + i / bytes_per_pixel + (rng() & 7)) & 0xff);
+            }
+        }
+        return result;
+    }
+} // namespace test_helpers
+
+#endif // TEST_HELPERS_HH
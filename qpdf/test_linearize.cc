@@ -0,0 +1,97 @@
+#include <qpdf/Buffer.hh>
+#include <qpdf/QPDF.hh>
+#include <qpdf/QPDFWriter.hh>
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Write each file given on the command line linearized with and without object streams and check
+// that the linearization of the result is valid and that the output doesn't depend on how
+// QPDFWriter keeps data between its passes.
+
+static std::unique_ptr<QPDF>
+open(char const* filename)
+{
+    auto pdf = std::make_unique<QPDF>();
+    pdf->setSuppressWarnings(true);
+    pdf->processFile(filename);
+    return pdf;
+}
+
+static std::shared_ptr<Buffer>
+linearize(
+    QPDF& pdf,
+    qpdf_object_stream_e object_streams,
+    std::function<void(QPDFWriter&)> configure = nullptr)
+{
+    QPDFWriter w(pdf);
+    w.setOutputMemory();
+    w.setStaticID(true);
+    w.setStaticAesIV(true);
+    w.setLinearization(true);
+    w.setObjectStreamMode(object_streams);
+    if (configure) {
+        configure(w);
+    }
+    w.write();
+    return w.getBufferSharedPointer();
+}
+
+static std::string
+to_string(Buffer const& b)
+{
+    return {reinterpret_cast<char const*>(b.getBuffer()), b.getSize()};
+}
+
+static void
+check(char const* filename)
+{
+    for (auto object_streams: {qpdf_o_disable, qpdf_o_generate}) {
+        auto b = linearize(*open(filename), object_streams);
+        QPDF pdf;
+        pdf.processMemoryFile(
+            filename, reinterpret_cast<char const*>(b->getBuffer()), b->getSize());
+        if (!(pdf.isLinearized() && pdf.checkLinearization() && !pdf.anyWarnings())) {
+            std::cout << filename << ": linearized output is not valid"
+                      << (object_streams == qpdf_o_generate ? " with object streams" : "")
+                      << std::endl;
+            exit(2);
+        }
+        // Keep none, part, or all of the data in memory between passes, with and without keeping
+        // the rest in a file.
+        for (bool cache_file: {false, true}) {
+            for (size_t cache_size: {size_t{0}, size_t{1000}, size_t{1} << 30}) {
+                auto other = linearize(*open(filename), object_streams, [&](QPDFWriter& w) {
+                    w.setLinearizationCacheSize(cache_size);
+                    w.setLinearizationCacheFile(cache_file);
+                });
+                if (to_string(*other) != to_string(*b)) {
+                    std::cout << filename << ": output differs with cache size " << cache_size
+                              << (cache_file ? " and cache file" : "") << std::endl;
+                    exit(2);
+                }
+            }
+        }
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: test_linearize file ..." << std::endl;
+        exit(2);
+    }
+    try {
+        for (int i = 1; i < argc; ++i) {
+            check(argv[i]);
+        }
+    } catch (std::exception& e) {
+        std::cerr << "test_linearize: " << e.what() << std::endl;
+        exit(2);
+    }
+    return 0;
+}
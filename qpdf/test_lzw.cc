@@ -0,0 +1,220 @@
+#include "test_helpers.hh"
+
+#include <qpdf/Pl_LZWDecoder.hh>
+#include <qpdf/QIntC.hh>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Encode a variety of data with and without early code change, decode it with Pl_LZWDecoder and
+// compare the result with the original data. Data is written in pieces of several sizes, including
+// one byte at a time, so that codes are split at different places, and some of it decodes to more
+// than the 64 KB that Pl_LZWDecoder collects before passing output on. Then decode some invalid
+// code sequences and print how much data was decoded and the error.
+
+using namespace test_helpers;
+
+// Write LZW codes most significant bit first, changing code size when the decoder would.
+class LZWCodeWriter
+{
+  public:
+    LZWCodeWriter(bool early_change) :
+        early_change(early_change)
+    {
+    }
+
+    // Write a code. If adds_entry, the decoder adds a table entry on reading it.
+    void
+    write(unsigned int code, bool adds_entry = false)
+    {
+        bits = (bits << code_size) | code;
+        bit_count += code_size;
+        while (bit_count >= 8) {
+            bit_count -= 8;
+            data += static_cast<char>((bits >> bit_count) & 0xff);
+        }
+        if (code == 256) {
+            entries = 0;
+            code_size = 9;
+        } else if (adds_entry) {
+            unsigned int change = 258 + entries++ + (early_change ? 1 : 0);
+            if (change == 511 || change == 1023 || change == 2047) {
+                ++code_size;
+            }
+        }
+    }
+
+    std::string
+    finish()
+    {
+        if (bit_count) {
+            data += static_cast<char>((bits << (8 - bit_count)) & 0xff);
+        }
+        return data;
+    }
+
+  private:
+    bool early_change;
+    unsigned long long bits{0};
+    unsigned int bit_count{0};
+    unsigned int code_size{9};
+    unsigned int entries{0};
+    std::string data;
+};
+
+static std::string
+lzw_encode(std::string const& data, bool early_change)
+{
+    LZWCodeWriter w(early_change);
+    std::map<std::pair<unsigned int, unsigned char>, unsigned int> table;
+    unsigned int next_code = 258;
+    bool first = true;
+    w.write(256);
+    unsigned int current = 0;
+    for (size_t i = 0; i < data.size(); ++i) {
+        auto ch = static_cast<unsigned char>(data[i]);
+        if (i == 0) {
+            current = ch;
+            continue;
+        }
+        auto iter = table.find({current, ch});
+        if (iter != table.end()) {
+            current = iter->second;
+            continue;
+        }
+        w.write(current, !first);
+        first = false;
+        table[{current, ch}] = next_code++;
+        current = ch;
+        if (next_code == 4000) {
+            // Start over well before the table is full.
+            w.write(256);
+            table.clear();
+            next_code = 258;
+            first = true;
+        }
+    }
+    if (!data.empty()) {
+        w.write(current, !first);
+    }
+    w.write(257);
+    return w.finish();
+}
+
+// Collect what is written and remember the largest single write.
+class Collector: public Pipeline
+{
+  public:
+    Collector() :
+        Pipeline("collector", nullptr)
+    {
+    }
+
+    void
+    write(unsigned char const* data, size_t len) override
+    {
+        result.append(reinterpret_cast<char const*>(data), len);
+        largest_write = std::max(largest_write, len);
+    }
+
+    void
+    finish() override
+    {
+    }
+
+    std::string result;
+    size_t largest_write{0};
+};
+
+// Write data to p in pieces of chunk bytes and finish it.
+static void
+write_in_pieces(Pipeline& p, std::string const& data, size_t chunk)
+{
+    auto buf = reinterpret_cast<unsigned char const*>(data.data());
+    for (size_t i = 0; i < data.size(); i += chunk) {
+        p.write(buf + i, std::min(chunk, data.size() - i));
+    }
+    p.finish();
+}
+
+// Decode data in pieces of chunk bytes. Return the error, if any, and the data decoded before it.
+static std::string
+try_decode(Collector& c, std::string const& data, size_t chunk)
+{
+    Pl_LZWDecoder lzw("lzw", &c, true);
+    try {
+        write_in_pieces(lzw, data, chunk);
+    } catch (std::exception& e) {
+        return e.what();
+    }
+    return "";
+}
+
+static void
+check_invalid(std::string const& description, std::vector<unsigned int> const& codes)
+{
+    LZWCodeWriter w(true);
+    unsigned int last = 256;
+    for (auto code: codes) {
+        w.write(code, last != 256 && code != 256 && code != 257);
+        last = code;
+    }
+    auto encoded = w.finish();
+    Collector c;
+    auto error = try_decode(c, encoded, encoded.size());
+    Collector c1;
+    if (try_decode(c1, encoded, 1) != error || c1.result != c.result) {
+        std::cout << description << ": result differs when written one byte at a time"
+                  << std::endl;
+        exit(2);
+    }
+    if (!error.empty()) {
+        std::cout << description << ": exception: " << error << std::endl;
+    }
+    std::cout << description << ": " << c.result.size() << " bytes" << std::endl;
+}
+
+int
+main()
+{
+    std::mt19937 rng(42);
+    for (bool early_change: {true, false}) {
+        for (int size: {0, 1, 2, 3, 10, 1000, 65535, 65536, 65537, 100000, 1000000}) {
+            auto n = QIntC::to_size(size);
+            for (auto const& data: {text(n, rng), random_bytes(n, rng), std::string(n, 'a')}) {
+                auto encoded = lzw_encode(data, early_change);
+                for (size_t chunk: {size_t(1), size_t(7), size_t(4099), encoded.size()}) {
+                    Collector c;
+                    Pl_LZWDecoder lzw("lzw", &c, early_change);
+                    write_in_pieces(lzw, encoded, chunk);
+                    // Output is passed on once at least 64 KB has been collected, so no single
+                    // write can be longer than that plus the longest string in the table.
+                    if (c.result != data || c.largest_write > 65536 + 4096) {
+                        std::cout << "decoding failed for " << size << " bytes"
+                                  << (early_change ? "" : " without early change")
+                                  << ", pieces of " << chunk << std::endl;
+                        exit(2);
+                    }
+                }
+            }
+        }
+    }
+
+    // Data after the end of data code is ignored.
+    check_invalid("data after end", {256, 65, 66, 258, 257, 65, 66});
+    check_invalid("no end", {256, 65, 66, 258});
+    check_invalid("entry before first", {256, 258, 65});
+    check_invalid("code too large", {256, 65, 66, 67, 300, 68});
+    std::vector<unsigned int> codes{256};
+    for (unsigned int i = 0; i < 4000; ++i) {
+        codes.push_back(i % 256);
+    }
+    check_invalid("table full", codes);
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "test_helpers.hh"
+
+#include <qpdf/Pl_PNGFilter.hh>
+#include <qpdf/Pl_String.hh>
+#include <qpdf/QIntC.hh>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+// Decode rows of random data encoded with each PNG filter with Pl_PNGFilter for a range of pixel
+// sizes and row lengths and compare the result with the original data. Filter types are mixed so
+// that each row is decoded after rows of different types. Then encode the data with Pl_PNGFilter,
+// which always uses the up filter, check the result and decode it again in the same chain. Data is
+// written in pieces of several sizes, including one byte at a time, so that rows are split at
+// different places.
+
+using namespace test_helpers;
+
+static int
+paeth(int a, int b, int c)
+{
+    int p = a + b - c;
+    int pa = std::abs(p - a);
+    int pb = std::abs(p - b);
+    int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+// Encode raw, which consists of rows of row_bytes bytes, using PNG filter types[r % types.size()]
+// for row r.
+static std::string
+png_encode(std::string const& raw, size_t row_bytes, size_t bpp, std::string const& types)
+{
+    std::string result;
+    std::string above(row_bytes, '\0');
+    for (size_t r = 0; r * row_bytes < raw.size(); ++r) {
+        auto row = raw.substr(r * row_bytes, row_bytes);
+        int type = types.at(r % types.size());
+        result += static_cast<char>(type);
+        for (size_t i = 0; i < row_bytes; ++i) {
+            int x = static_cast<unsigned char>(row[i]);
+            int a = i >= bpp ? static_cast<unsigned char>(row[i - bpp]) : 0;
+            int b = static_cast<unsigned char>(above[i]);
+            int c = i >= bpp ? static_cast<unsigned char>(above[i - bpp]) : 0;
+            int predictor = 0;
+            switch (type) {
+            case 1:
+                predictor = a;
+                break;
+            case 2:
+                predictor = b;
+                break;
+            case 3:
+                predictor = (a + b) / 2;
+                break;
+            case 4:
+                predictor = paeth(a, b, c);
+                break;
+            default:
+                break;
+            }
+            result += static_cast<char>((x - predictor) & 0xff);
+        }
+        above = row;
+    }
+    return result;
+}
+
+// Write data to p in pieces of chunk bytes and finish it.
+static void
+write_in_pieces(Pipeline& p, std::string const& data, size_t chunk)
+{
+    auto buf = reinterpret_cast<unsigned char const*>(data.data());
+    for (size_t i = 0; i < data.size(); i += chunk) {
+        p.write(buf + i, std::min(chunk, data.size() - i));
+    }
+    p.finish();
+}
+
+int
+main()
+{
+    std::mt19937 rng(42);
+    for (unsigned int colors = 1; colors <= 4; ++colors) {
+        for (unsigned int bits: {1U, 2U, 4U, 8U, 16U}) {
+            for (unsigned int columns: {1U, 2U, 3U, 5U, 8U, 17U, 64U, 100U}) {
+                size_t bpp = (colors * bits + 7) / 8;
+                size_t row_bytes = (columns * colors * bits + 7) / 8;
+                auto raw = random_bytes(12 * row_bytes, rng);
+                auto encoded =
+                    png_encode(raw, row_bytes, bpp, std::string("\0\1\2\3\4\2\0\4\1\3\2", 11));
+                auto encoded_up = png_encode(raw, row_bytes, bpp, "\2");
+                for (size_t chunk: {size_t(1), size_t(7), row_bytes + 2, encoded.size()}) {
+                    auto fail = [&](char const* what) {
+                        std::cout << what << " failed for colors " << colors << ", bits " << bits
+                                  << ", columns " << columns << ", pieces of " << chunk
+                                  << std::endl;
+                        exit(2);
+                    };
+
+                    std::string decoded;
+                    Pl_String s_decoded("decoded", nullptr, decoded);
+                    Pl_PNGFilter decode(
+                        "decode", &s_decoded, Pl_PNGFilter::a_decode, columns, colors, bits);
+                    write_in_pieces(decode, encoded, chunk);
+                    if (decoded != raw) {
+                        fail("decoding");
+                    }
+
+                    std::string round_trip;
+                    Pl_String s_round_trip("round trip", nullptr, round_trip);
+                    Pl_PNGFilter decode2(
+                        "decode", &s_round_trip, Pl_PNGFilter::a_decode, columns, colors, bits);
+                    std::string encoded2;
+                    Pl_String s_encoded("encoded", &decode2, encoded2);
+                    Pl_PNGFilter encode(
+                        "encode", &s_encoded, Pl_PNGFilter::a_encode, columns, colors, bits);
+                    write_in_pieces(encode, raw, chunk);
+                    if (encoded2 != encoded_up) {
+                        fail("encoding");
+                    }
+                    if (round_trip != raw) {
+                        fail("round trip");
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -10,13 +10,17 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 static char const* whoami = nullptr;
+static bool suppress_warnings = false;
 
 void
 usage()
 {
-    std::cerr << "Usage: " << whoami << " [-maxlen len | -no-ignorable] filename" << std::endl;
+    std::cerr << "Usage: " << whoami << " [-maxlen len | -no-ignorable] filename" << std::endl
+              << "       " << whoami << " -compare filename ..." << std::endl;
     exit(2);
 }
 
@@ -47,6 +51,64 @@ Finder::check()
     return result;
 }
 
+namespace
+{
+    // Read from another input source without making its contents available as contiguous data, so
+    // the tokenizer reads a character at a time.
+    class NonContiguousInputSource: public InputSource
+    {
+      public:
+        NonContiguousInputSource(std::shared_ptr<InputSource> is) :
+            is(is)
+        {
+        }
+        ~NonContiguousInputSource() override = default;
+
+        qpdf_offset_t
+        findAndSkipNextEOL() override
+        {
+            auto result = is->findAndSkipNextEOL();
+            last_offset = is->getLastOffset();
+            return result;
+        }
+        std::string const&
+        getName() const override
+        {
+            return is->getName();
+        }
+        qpdf_offset_t
+        tell() override
+        {
+            return is->tell();
+        }
+        void
+        seek(qpdf_offset_t offset, int whence) override
+        {
+            is->seek(offset, whence);
+        }
+        void
+        rewind() override
+        {
+            is->rewind();
+        }
+        size_t
+        read(char* buffer, size_t length) override
+        {
+            auto result = is->read(buffer, length);
+            last_offset = is->getLastOffset();
+            return result;
+        }
+        void
+        unreadCh(char ch) override
+        {
+            is->unreadCh(ch);
+        }
+
+      private:
+        std::shared_ptr<InputSource> is;
+    };
+} // namespace
+
 static char const*
 tokenTypeName(QPDFTokenizer::token_type_e ttype)
 {
@@ -113,12 +175,13 @@ try_skipping(
     std::shared_ptr<InputSource> is,
     size_t max_len,
     char const* what,
-    Finder& f)
+    Finder& f,
+    std::ostream& out)
 {
-    std::cout << "skipping to " << what << std::endl;
+    out << "skipping to " << what << std::endl;
     qpdf_offset_t offset = is->tell();
     if (!is->findFirst(what, offset, 0, f)) {
-        std::cout << what << " not found" << std::endl;
+        out << what << " not found" << std::endl;
         is->seek(offset, SEEK_SET);
     }
 }
@@ -130,10 +193,11 @@ dump_tokens(
     size_t max_len,
     bool include_ignorable,
     bool skip_streams,
-    bool skip_inline_images)
+    bool skip_inline_images,
+    std::ostream& out)
 {
     Finder f1(is, "endstream");
-    std::cout << "--- BEGIN " << label << " ---" << std::endl;
+    out << "--- BEGIN " << label << " ---" << std::endl;
     bool done = false;
     QPDFTokenizer tokenizer;
     tokenizer.allowEOF();
@@ -145,7 +209,7 @@ dump_tokens(
         QPDFTokenizer::Token token =
             tokenizer.readToken(is, "test", true, inline_image_offset ? 0 : max_len);
         if (inline_image_offset && (token.getType() == QPDFTokenizer::tt_bad)) {
-            std::cout << "EI not found; resuming normal scanning" << std::endl;
+            out << "EI not found; resuming normal scanning" << std::endl;
             is->seek(inline_image_offset, SEEK_SET);
             inline_image_offset = 0;
             continue;
@@ -153,19 +217,19 @@ dump_tokens(
         inline_image_offset = 0;
 
         qpdf_offset_t offset = is->getLastOffset();
-        std::cout << offset << ": " << tokenTypeName(token.getType());
+        out << offset << ": " << tokenTypeName(token.getType());
         if (token.getType() != QPDFTokenizer::tt_eof) {
-            std::cout << ": " << sanitize(token.getValue());
+            out << ": " << sanitize(token.getValue());
             if (token.getValue() != token.getRawValue()) {
-                std::cout << " (raw: " << sanitize(token.getRawValue()) << ")";
+                out << " (raw: " << sanitize(token.getRawValue()) << ")";
             }
         }
         if (!token.getErrorMessage().empty()) {
-            std::cout << " (" << token.getErrorMessage() << ")";
+            out << " (" << token.getErrorMessage() << ")";
         }
-        std::cout << std::endl;
+        out << std::endl;
         if (skip_streams && (token == QPDFTokenizer::Token(QPDFTokenizer::tt_word, "stream"))) {
-            try_skipping(tokenizer, is, max_len, "endstream", f1);
+            try_skipping(tokenizer, is, max_len, "endstream", f1, out);
         } else if (
             skip_inline_images && (token == QPDFTokenizer::Token(QPDFTokenizer::tt_word, "ID"))) {
             char ch;
@@ -176,21 +240,51 @@ dump_tokens(
             done = true;
         }
     }
-    std::cout << "--- END " << label << " ---" << std::endl;
+    out << "--- END " << label << " ---" << std::endl;
 }
 
+// The tokenizer reads BufferInputSource directly from memory. If contiguous is false, hide that so
+// the tokenizer reads buf a character at a time.
+static std::shared_ptr<InputSource>
+make_source(std::shared_ptr<Buffer> buf, std::string const& description, bool contiguous)
+{
+    std::shared_ptr<InputSource> is = std::make_shared<BufferInputSource>(description, buf.get());
+    if (!contiguous) {
+        is = std::make_shared<NonContiguousInputSource>(is);
+    }
+    return is;
+}
+
+// If contiguous_file is true, tokenize the file from memory rather than from FileInputSource. If
+// contiguous is false, tokenize content and object streams a character at a time.
 static void
-process(char const* filename, bool include_ignorable, size_t max_len)
+process(
+    char const* filename,
+    bool include_ignorable,
+    size_t max_len,
+    std::ostream& out = std::cout,
+    bool contiguous = true,
+    bool contiguous_file = false)
 {
     std::shared_ptr<InputSource> is;
 
     // Tokenize file, skipping streams
-    auto* fis = new FileInputSource(filename);
-    is = std::shared_ptr<InputSource>(fis);
-    dump_tokens(is, "FILE", max_len, include_ignorable, true, false);
+    std::shared_ptr<Buffer> file_data;
+    if (contiguous_file) {
+        auto contents = QUtil::read_file_into_string(filename);
+        file_data = std::make_shared<Buffer>(contents.size());
+        if (!contents.empty()) {
+            memcpy(file_data->getBuffer(), contents.data(), contents.size());
+        }
+        is = make_source(file_data, filename, true);
+    } else {
+        is = std::make_shared<FileInputSource>(filename);
+    }
+    dump_tokens(is, "FILE", max_len, include_ignorable, true, false, out);
 
     // Tokenize content streams, skipping inline images
     QPDF qpdf;
+    qpdf.setSuppressWarnings(suppress_warnings);
     qpdf.processFile(filename);
     int pageno = 0;
     for (auto& page: QPDFPageDocumentHelper(qpdf).getAllPages()) {
@@ -198,10 +292,15 @@ process(char const* filename, bool include_ignorable, size_t max_len)
         Pl_Buffer plb("buffer");
         page.pipeContents(&plb);
         auto content_data = plb.getBufferSharedPointer();
-        auto* bis = new BufferInputSource("content data", content_data.get());
-        is = std::shared_ptr<InputSource>(bis);
+        is = make_source(content_data, "content data", contiguous);
         dump_tokens(
-            is, "PAGE " + QUtil::int_to_string(pageno), max_len, include_ignorable, false, true);
+            is,
+            "PAGE " + QUtil::int_to_string(pageno),
+            max_len,
+            include_ignorable,
+            false,
+            true,
+            out);
     }
 
     // Tokenize object streams
@@ -209,17 +308,50 @@ process(char const* filename, bool include_ignorable, size_t max_len)
         if (obj.isStream() && obj.getDict().getKey("/Type").isName() &&
             obj.getDict().getKey("/Type").getName() == "/ObjStm") {
             std::shared_ptr<Buffer> b = obj.getStreamData(qpdf_dl_specialized);
-            auto* bis = new BufferInputSource("object stream data", b.get());
-            is = std::shared_ptr<InputSource>(bis);
+            is = make_source(b, "object stream data", contiguous);
             dump_tokens(
                 is,
                 "OBJECT STREAM " + QUtil::int_to_string(obj.getObjectID()),
                 max_len,
                 include_ignorable,
                 false,
-                false);
+                false,
+                out);
+        }
+    }
+}
+
+// Check that the tokenizer produces the same tokens when reading directly from memory as it does
+// when reading a character at a time.
+static void
+compare(std::vector<char const*> const& filenames)
+{
+    suppress_warnings = true;
+    int errors = 0;
+    for (auto filename: filenames) {
+        for (bool include_ignorable: {true, false}) {
+            std::ostringstream direct;
+            std::ostringstream buffered;
+            for (bool contiguous: {true, false}) {
+                auto& out = contiguous ? direct : buffered;
+                try {
+                    process(filename, include_ignorable, 0, out, contiguous, contiguous);
+                } catch (std::exception& e) {
+                    out << "exception: " << e.what() << std::endl;
+                }
+            }
+            if (direct.str() != buffered.str()) {
+                ++errors;
+                std::cout << filename << (include_ignorable ? "" : " (no ignorable)")
+                          << ": tokens differ" << std::endl;
+            }
         }
     }
+    if (errors == 0) {
+        std::cout << "tokens match" << std::endl;
+    } else {
+        exit(2);
+    }
 }
 
 int
@@ -235,6 +367,15 @@ main(int argc, char* argv[])
     char const* filename = nullptr;
     size_t max_len = 0;
     bool include_ignorable = true;
+    if ((argc > 2) && (strcmp(argv[1], "-compare") == 0)) {
+        try {
+            compare(std::vector<char const*>(argv + 2, argv + argc));
+        } catch (std::exception& e) {
+            std::cerr << whoami << ": exception: " << e.what();
+            exit(2);
+        }
+        return 0;
+    }
     for (int i = 1; i < argc; ++i) {
         if (argv[i][0] == '-') {
             if (strcmp(argv[i], "-maxlen") == 0) {